@@ -0,0 +1,483 @@
+#pragma once
+#include "CRCKernel.h"
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+enum CRCAlgorithm {
+	CRC4_ITU,
+	CRC5_EPC,
+	CRC5_ITU,
+	CRC5_USB,
+	CRC6_CDMA2000A,
+	CRC6_CDMA2000B,
+	CRC6_ITU,
+	CRC6_NR,
+	CRC7,
+	CRC8,
+	CRC8_EBU,
+	CRC8_MAXIM,
+	CRC8_WCDMA,
+	CRC8_LTE,
+	CRC10,
+	CRC10_CDMA2000,
+	CRC11,
+	CRC11_NR,
+	CRC12_CDMA2000,
+	CRC12_DECT,
+	CRC12_UMTS,
+	CRC13_BCC,
+	CRC15,
+	CRC15_MPT1327,
+	CRC16_ARC,
+	CRC16_BUYPASS,
+	CRC16_MCRF4XX,
+	CRC16_CCITTFALSE,
+	CRC16_CDMA2000,
+	CRC16_CMS,
+	CRC16_DECTR,
+	CRC16_DECTX,
+	CRC16_DNP,
+	CRC16_GENIBUS,
+	CRC16_KERMIT,
+	CRC16_MAXIM,
+	CRC16_MODBUS,
+	CRC16_T10DIF,
+	CRC16_USB,
+	CRC16_X25,
+	CRC16_XMODEM,
+	CRC17_CAN,
+	CRC21_CAN,
+	CRC24,
+	CRC24_FLEXRAYA,
+	CRC24_FLEXRAYB,
+	CRC24_LTEA,
+	CRC24_LTEB,
+	CRC24_NRC,
+	CRC30,
+	CRC32,
+	CRC32_BZIP2,
+	CRC32_C,
+	CRC32_MPEG2,
+	CRC32_POSIX,
+	CRC32_Q,
+	CRC40_GSM,
+	CRC64,
+	XOR8,
+	XOR16,
+	XOR32,
+	XOR8_MASK_MAJOR_BIT,
+	CRC_CUSTOM, /*	Parameters given at run time.	*/
+};
+
+/**
+ * Algorithms by their command line name.
+ */
+static std::unordered_map<std::string, CRCAlgorithm> const crcAlgorithmTable = {
+	{"crc4_itu", CRCAlgorithm::CRC4_ITU},
+	{"crc5_epc", CRCAlgorithm::CRC5_EPC},
+	{"crc5_itu", CRCAlgorithm::CRC5_ITU},
+	{"crc5_usb", CRCAlgorithm::CRC5_USB},
+	{"crc6_cmda2000a", CRCAlgorithm::CRC6_CDMA2000A},
+	{"crc6_cmda2000b", CRCAlgorithm::CRC6_CDMA2000B},
+	{"crc6_itu", CRCAlgorithm::CRC6_ITU},
+	{"crc6_nr", CRCAlgorithm::CRC6_NR},
+
+	{"crc7", CRCAlgorithm::CRC7},
+	{"crc8", CRCAlgorithm::CRC8},
+
+	{"crc8_ebu", CRCAlgorithm::CRC8_EBU},
+	{"crc8_maxim", CRCAlgorithm::CRC8_MAXIM},
+	{"crc8_wcdma", CRCAlgorithm::CRC8_WCDMA},
+	{"crc8_lte", CRCAlgorithm::CRC8_LTE},
+
+	{"crc10", CRCAlgorithm::CRC10},
+	{"crc10_cdma2000", CRCAlgorithm::CRC10_CDMA2000},
+	{"crc11", CRCAlgorithm::CRC11},
+	{"crc11_nr", CRCAlgorithm::CRC11_NR},
+	{"crc12_cdma2000", CRCAlgorithm::CRC12_CDMA2000},
+	{"crc12_dect", CRCAlgorithm::CRC12_DECT},
+	{"crc12_umts", CRCAlgorithm::CRC12_UMTS},
+	{"crc13_bcc", CRCAlgorithm::CRC13_BCC},
+	{"crc15", CRCAlgorithm::CRC15},
+	{"crc15_mpt1327", CRCAlgorithm::CRC15_MPT1327},
+	{"crc16_arc", CRCAlgorithm::CRC16_ARC},
+	{"crc16_buypass", CRCAlgorithm::CRC16_BUYPASS},
+	{"crc16_mcrf4xx", CRCAlgorithm::CRC16_MCRF4XX},
+	{"crc16_ccittfalse", CRCAlgorithm::CRC16_CCITTFALSE},
+	{"crc16_cdma2000", CRCAlgorithm::CRC16_CDMA2000},
+	{"crc16_cms", CRCAlgorithm::CRC16_CMS},
+	{"crc16_dectr", CRCAlgorithm::CRC16_DECTR},
+	{"crc16_dectx", CRCAlgorithm::CRC16_DECTX},
+	{"crc16_dnp", CRCAlgorithm::CRC16_DNP},
+	{"crc16_genibus", CRCAlgorithm::CRC16_GENIBUS},
+	{"crc16_kermit", CRCAlgorithm::CRC16_KERMIT},
+	{"crc16_maxim", CRCAlgorithm::CRC16_MAXIM},
+	{"crc16_modbus", CRCAlgorithm::CRC16_MODBUS},
+	{"crc16_t10dif", CRCAlgorithm::CRC16_T10DIF},
+	{"crc16_usb", CRCAlgorithm::CRC16_USB},
+	{"crc16_x25", CRCAlgorithm::CRC16_X25},
+	{"crc16_xmodem", CRCAlgorithm::CRC16_XMODEM},
+	{"crc17_can", CRCAlgorithm::CRC17_CAN},
+	{"crc21_can", CRCAlgorithm::CRC21_CAN},
+	{"crc24", CRCAlgorithm::CRC24},
+	{"crc24_flexraya", CRCAlgorithm::CRC24_FLEXRAYA},
+	{"crc24_flexrayb", CRCAlgorithm::CRC24_FLEXRAYB},
+	{"crc24_ltea", CRCAlgorithm::CRC24_LTEA},
+	{"crc24_lteb", CRCAlgorithm::CRC24_LTEB},
+	{"crc24_nrc", CRCAlgorithm::CRC24_NRC},
+
+	{"crc30", CRCAlgorithm::CRC30},
+	{"crc32", CRCAlgorithm::CRC32},
+	{"crc32_bzip2", CRCAlgorithm::CRC32_BZIP2},
+	{"crc32_c", CRCAlgorithm::CRC32_C},
+	{"crc32_mpeg2", CRCAlgorithm::CRC32_MPEG2},
+	{"crc32_posix", CRCAlgorithm::CRC32_POSIX},
+	{"crc32_q", CRCAlgorithm::CRC32_Q},
+	{"crc40_gsm", CRCAlgorithm::CRC40_GSM},
+	{"crc64", CRCAlgorithm::CRC64},
+	{"xor8", CRCAlgorithm::XOR8},
+	{"xor16", CRCAlgorithm::XOR16},
+	{"xor32", CRCAlgorithm::XOR32},
+	{"xor8_masked", CRCAlgorithm::XOR8_MASK_MAJOR_BIT},
+	{"custom", CRCAlgorithm::CRC_CUSTOM}};
+
+/*	Name of the algorithm with the parameters given on the command line, not part of the predefined list.	*/
+static const std::string customCRCName = "custom";
+
+/**
+ * Compile-time mapping between the algorithm and its kernel.
+ */
+template <CRCAlgorithm algorithm> struct CRCAlgorithmTraits;
+
+template <> struct CRCAlgorithmTraits<CRC4_ITU> {
+	using Kernel = CRCTableKernel<uint8_t, 4, 0x3, 0x0, 0x0, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC5_EPC> {
+	using Kernel = CRCTableKernel<uint8_t, 5, 0x09, 0x09, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC5_ITU> {
+	using Kernel = CRCTableKernel<uint8_t, 5, 0x15, 0x00, 0x00, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC5_USB> {
+	using Kernel = CRCTableKernel<uint8_t, 5, 0x05, 0x1F, 0x1F, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC6_CDMA2000A> {
+	using Kernel = CRCTableKernel<uint8_t, 6, 0x27, 0x3F, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC6_CDMA2000B> {
+	using Kernel = CRCTableKernel<uint8_t, 6, 0x07, 0x3F, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC6_ITU> {
+	using Kernel = CRCTableKernel<uint8_t, 6, 0x03, 0x00, 0x00, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC6_NR> {
+	using Kernel = CRCTableKernel<uint8_t, 6, 0x21, 0x00, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC7> {
+	using Kernel = CRCTableKernel<uint8_t, 7, 0x09, 0x00, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC8> {
+	using Kernel = CRCTableKernel<uint8_t, 8, 0x07, 0x00, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC8_EBU> {
+	using Kernel = CRCTableKernel<uint8_t, 8, 0x1D, 0xFF, 0x00, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC8_MAXIM> {
+	using Kernel = CRCTableKernel<uint8_t, 8, 0x31, 0x00, 0x00, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC8_WCDMA> {
+	using Kernel = CRCTableKernel<uint8_t, 8, 0x9B, 0x00, 0x00, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC8_LTE> {
+	using Kernel = CRCTableKernel<uint8_t, 8, 0x9B, 0x00, 0x00, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC10> {
+	using Kernel = CRCTableKernel<uint16_t, 10, 0x233, 0x000, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC10_CDMA2000> {
+	using Kernel = CRCTableKernel<uint16_t, 10, 0x3D9, 0x3FF, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC11> {
+	using Kernel = CRCTableKernel<uint16_t, 11, 0x385, 0x01A, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC11_NR> {
+	using Kernel = CRCTableKernel<uint16_t, 11, 0x621, 0x000, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC12_CDMA2000> {
+	using Kernel = CRCTableKernel<uint16_t, 12, 0xF13, 0xFFF, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC12_DECT> {
+	using Kernel = CRCTableKernel<uint16_t, 12, 0x80F, 0x000, 0x000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC12_UMTS> {
+	using Kernel = CRCTableKernel<uint16_t, 12, 0x80F, 0x000, 0x000, false, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC13_BCC> {
+	using Kernel = CRCTableKernel<uint16_t, 13, 0x1CF5, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC15> {
+	using Kernel = CRCTableKernel<uint16_t, 15, 0x4599, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC15_MPT1327> {
+	using Kernel = CRCTableKernel<uint16_t, 15, 0x6815, 0x0000, 0x0001, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_ARC> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0x0000, 0x0000, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_BUYPASS> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_MCRF4XX> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0xFFFF, 0x0000, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_CCITTFALSE> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0xFFFF, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_CDMA2000> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0xC867, 0xFFFF, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_CMS> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0xFFFF, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_DECTR> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x0589, 0x0000, 0x0001, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_DECTX> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x0589, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_DNP> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x3D65, 0x0000, 0xFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_GENIBUS> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0xFFFF, 0xFFFF, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_KERMIT> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0x0000, 0x0000, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_MAXIM> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0x0000, 0xFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_MODBUS> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0xFFFF, 0x0000, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_T10DIF> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8BB7, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_USB> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x8005, 0xFFFF, 0xFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_X25> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0xFFFF, 0xFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC16_XMODEM> {
+	using Kernel = CRCTableKernel<uint16_t, 16, 0x1021, 0x0000, 0x0000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC17_CAN> {
+	using Kernel = CRCTableKernel<uint32_t, 17, 0x1685B, 0x00000, 0x00000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC21_CAN> {
+	using Kernel = CRCTableKernel<uint32_t, 21, 0x102899, 0x000000, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0x864CFB, 0xB704CE, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24_FLEXRAYA> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0x5D6DCB, 0xFEDCBA, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24_FLEXRAYB> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0x5D6DCB, 0xABCDEF, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24_LTEA> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0x864CFB, 0x000000, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24_LTEB> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0x800063, 0x000000, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC24_NRC> {
+	using Kernel = CRCTableKernel<uint32_t, 24, 0xB2B117, 0x000000, 0x000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC30> {
+	using Kernel = CRCTableKernel<uint32_t, 30, 0x2030B9C7, 0x3FFFFFFF, 0x00000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC32> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC32_BZIP2> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC32_C> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true>;
+};
+template <> struct CRCAlgorithmTraits<CRC32_MPEG2> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, 0x00000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC32_POSIX> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x04C11DB7, 0x00000000, 0xFFFFFFFF, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC32_Q> {
+	using Kernel = CRCTableKernel<uint32_t, 32, 0x814141AB, 0x00000000, 0x00000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC40_GSM> {
+	using Kernel = CRCTableKernel<uint64_t, 40, 0x0000000004820009, 0x0000000000, 0xFFFFFFFFFF, false, false>;
+};
+template <> struct CRCAlgorithmTraits<CRC64> {
+	using Kernel = CRCTableKernel<uint64_t, 64, 0x42F0E1EBA9EA3693, 0x0000000000000000, 0x0000000000000000, false, false>;
+};
+template <> struct CRCAlgorithmTraits<XOR8> {
+	using Kernel = XORKernel<uint8_t, 0xFF>;
+};
+template <> struct CRCAlgorithmTraits<XOR16> {
+	using Kernel = XORKernel<uint16_t, 0xFF>;
+};
+template <> struct CRCAlgorithmTraits<XOR32> {
+	using Kernel = XORKernel<uint32_t, 0xFF>;
+};
+template <> struct CRCAlgorithmTraits<XOR8_MASK_MAJOR_BIT> {
+	using Kernel = XORKernel<uint8_t, 0x7F>;
+};
+
+template <> struct CRCAlgorithmTraits<CRC_CUSTOM> {
+	using Kernel = CRCCustomKernel;
+};
+
+template <CRCAlgorithm algorithm> using CRCAlgorithmKernel = typename CRCAlgorithmTraits<algorithm>::Kernel;
+
+/**
+ * Invoke func with an instance of the kernel type for the algorithm. Performing the
+ * dispatch once allows everything inside func to be specialized for a single algorithm.
+ */
+template <typename Func> static auto dispatchCRCAlgorithm(CRCAlgorithm algorithm, Func &&func) {
+	switch (algorithm) {
+	case CRC4_ITU:
+		return func(CRCAlgorithmKernel<CRC4_ITU>{});
+	case CRC5_EPC:
+		return func(CRCAlgorithmKernel<CRC5_EPC>{});
+	case CRC5_ITU:
+		return func(CRCAlgorithmKernel<CRC5_ITU>{});
+	case CRC5_USB:
+		return func(CRCAlgorithmKernel<CRC5_USB>{});
+	case CRC6_CDMA2000A:
+		return func(CRCAlgorithmKernel<CRC6_CDMA2000A>{});
+	case CRC6_CDMA2000B:
+		return func(CRCAlgorithmKernel<CRC6_CDMA2000B>{});
+	case CRC6_ITU:
+		return func(CRCAlgorithmKernel<CRC6_ITU>{});
+	case CRC6_NR:
+		return func(CRCAlgorithmKernel<CRC6_NR>{});
+	case CRC7:
+		return func(CRCAlgorithmKernel<CRC7>{});
+	case CRC8:
+		return func(CRCAlgorithmKernel<CRC8>{});
+	case CRC8_EBU:
+		return func(CRCAlgorithmKernel<CRC8_EBU>{});
+	case CRC8_MAXIM:
+		return func(CRCAlgorithmKernel<CRC8_MAXIM>{});
+	case CRC8_WCDMA:
+		return func(CRCAlgorithmKernel<CRC8_WCDMA>{});
+	case CRC8_LTE:
+		return func(CRCAlgorithmKernel<CRC8_LTE>{});
+	case CRC10:
+		return func(CRCAlgorithmKernel<CRC10>{});
+	case CRC10_CDMA2000:
+		return func(CRCAlgorithmKernel<CRC10_CDMA2000>{});
+	case CRC11:
+		return func(CRCAlgorithmKernel<CRC11>{});
+	case CRC11_NR:
+		return func(CRCAlgorithmKernel<CRC11_NR>{});
+	case CRC12_CDMA2000:
+		return func(CRCAlgorithmKernel<CRC12_CDMA2000>{});
+	case CRC12_DECT:
+		return func(CRCAlgorithmKernel<CRC12_DECT>{});
+	case CRC12_UMTS:
+		return func(CRCAlgorithmKernel<CRC12_UMTS>{});
+	case CRC13_BCC:
+		return func(CRCAlgorithmKernel<CRC13_BCC>{});
+	case CRC15:
+		return func(CRCAlgorithmKernel<CRC15>{});
+	case CRC15_MPT1327:
+		return func(CRCAlgorithmKernel<CRC15_MPT1327>{});
+	case CRC16_ARC:
+		return func(CRCAlgorithmKernel<CRC16_ARC>{});
+	case CRC16_BUYPASS:
+		return func(CRCAlgorithmKernel<CRC16_BUYPASS>{});
+	case CRC16_MCRF4XX:
+		return func(CRCAlgorithmKernel<CRC16_MCRF4XX>{});
+	case CRC16_CCITTFALSE:
+		return func(CRCAlgorithmKernel<CRC16_CCITTFALSE>{});
+	case CRC16_CDMA2000:
+		return func(CRCAlgorithmKernel<CRC16_CDMA2000>{});
+	case CRC16_CMS:
+		return func(CRCAlgorithmKernel<CRC16_CMS>{});
+	case CRC16_DECTR:
+		return func(CRCAlgorithmKernel<CRC16_DECTR>{});
+	case CRC16_DECTX:
+		return func(CRCAlgorithmKernel<CRC16_DECTX>{});
+	case CRC16_DNP:
+		return func(CRCAlgorithmKernel<CRC16_DNP>{});
+	case CRC16_GENIBUS:
+		return func(CRCAlgorithmKernel<CRC16_GENIBUS>{});
+	case CRC16_KERMIT:
+		return func(CRCAlgorithmKernel<CRC16_KERMIT>{});
+	case CRC16_MAXIM:
+		return func(CRCAlgorithmKernel<CRC16_MAXIM>{});
+	case CRC16_MODBUS:
+		return func(CRCAlgorithmKernel<CRC16_MODBUS>{});
+	case CRC16_T10DIF:
+		return func(CRCAlgorithmKernel<CRC16_T10DIF>{});
+	case CRC16_USB:
+		return func(CRCAlgorithmKernel<CRC16_USB>{});
+	case CRC16_X25:
+		return func(CRCAlgorithmKernel<CRC16_X25>{});
+	case CRC16_XMODEM:
+		return func(CRCAlgorithmKernel<CRC16_XMODEM>{});
+	case CRC17_CAN:
+		return func(CRCAlgorithmKernel<CRC17_CAN>{});
+	case CRC21_CAN:
+		return func(CRCAlgorithmKernel<CRC21_CAN>{});
+	case CRC24:
+		return func(CRCAlgorithmKernel<CRC24>{});
+	case CRC24_FLEXRAYA:
+		return func(CRCAlgorithmKernel<CRC24_FLEXRAYA>{});
+	case CRC24_FLEXRAYB:
+		return func(CRCAlgorithmKernel<CRC24_FLEXRAYB>{});
+	case CRC24_LTEA:
+		return func(CRCAlgorithmKernel<CRC24_LTEA>{});
+	case CRC24_LTEB:
+		return func(CRCAlgorithmKernel<CRC24_LTEB>{});
+	case CRC24_NRC:
+		return func(CRCAlgorithmKernel<CRC24_NRC>{});
+	case CRC30:
+		return func(CRCAlgorithmKernel<CRC30>{});
+	case CRC32:
+		return func(CRCAlgorithmKernel<CRC32>{});
+	case CRC32_BZIP2:
+		return func(CRCAlgorithmKernel<CRC32_BZIP2>{});
+	case CRC32_C:
+		return func(CRCAlgorithmKernel<CRC32_C>{});
+	case CRC32_MPEG2:
+		return func(CRCAlgorithmKernel<CRC32_MPEG2>{});
+	case CRC32_POSIX:
+		return func(CRCAlgorithmKernel<CRC32_POSIX>{});
+	case CRC32_Q:
+		return func(CRCAlgorithmKernel<CRC32_Q>{});
+	case CRC40_GSM:
+		return func(CRCAlgorithmKernel<CRC40_GSM>{});
+	case CRC64:
+		return func(CRCAlgorithmKernel<CRC64>{});
+	case XOR8:
+		return func(CRCAlgorithmKernel<XOR8>{});
+	case XOR16:
+		return func(CRCAlgorithmKernel<XOR16>{});
+	case XOR32:
+		return func(CRCAlgorithmKernel<XOR32>{});
+	case XOR8_MASK_MAJOR_BIT:
+		return func(CRCAlgorithmKernel<XOR8_MASK_MAJOR_BIT>{});
+	case CRC_CUSTOM:
+		return func(CRCAlgorithmKernel<CRC_CUSTOM>{});
+	default:
+		assert(0);
+		return func(CRCAlgorithmKernel<CRC8>{});
+	}
+}
@@ -0,0 +1,172 @@
+#include "CRCAnalytic.h"
+#include "marl/defer.h"
+#include "marl/scheduler.h"
+#include "marl/waitgroup.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+/**
+ * Zero the sums that cancel to within the precision of their largest term, A_w is exactly zero below the
+ * distance of the code.
+ */
+static inline long double roundCancelled(long double sum, long double largestTerm) noexcept {
+	return sum > 64 * LDBL_EPSILON * largestTerm ? sum : 0;
+}
+
+std::vector<uint64_t> computeDualWeightDistribution(const std::vector<uint64_t> &syndromes, unsigned int width) {
+	assert(width <= analyticMaxWidth);
+	const uint64_t nrBits = syndromes.size();
+	const uint64_t nrChecks = static_cast<uint64_t>(1) << width;
+
+	/*	Sum over the syndromes of (-1)^parity(u & syndrome) is nrBits - 2 * w(u), the transform of the
+	 *	multiplicity of every syndrome.	*/
+	std::vector<int64_t> transform(nrChecks, 0);
+	for (const uint64_t syndrome : syndromes) {
+		assert(syndrome < nrChecks);
+		transform[syndrome]++;
+	}
+
+	/*	Every stage of butterflies is split into a range per worker.	*/
+	const uint64_t nrButterflies = nrChecks / 2;
+	const uint32_t nrWorkers = std::max<uint32_t>(1, marl::Scheduler::get()->config().workerThread.count);
+	const uint64_t rangeSize = std::max<uint64_t>(4096, (nrButterflies + nrWorkers - 1) / nrWorkers);
+
+	for (uint64_t half = 1; half < nrChecks; half *= 2) {
+		const uint64_t nrRanges = (nrButterflies + rangeSize - 1) / rangeSize;
+		marl::WaitGroup stageDone(static_cast<unsigned int>(nrRanges));
+
+		for (uint64_t range = 0; range < nrRanges; range++) {
+			marl::schedule([&, half, range] {
+				defer(stageDone.done());
+
+				const uint64_t end = std::min(nrButterflies, (range + 1) * rangeSize);
+				for (uint64_t k = range * rangeSize; k < end; k++) {
+					const uint64_t i = (k / half) * 2 * half + k % half;
+					const int64_t a = transform[i];
+					const int64_t b = transform[i + half];
+					transform[i] = a + b;
+					transform[i + half] = a - b;
+				}
+			});
+		}
+		stageDone.wait();
+	}
+
+	std::vector<uint64_t> dualWeights(nrBits + 1, 0);
+	for (const int64_t value : transform) {
+		dualWeights[(static_cast<int64_t>(nrBits) - value) / 2]++;
+	}
+	return dualWeights;
+}
+
+long double computeUndetectedRandomFlips(const std::vector<uint64_t> &dualWeights, unsigned int width,
+										 unsigned int nrBitError) {
+	const uint64_t nrBits = dualWeights.size() - 1;
+	const long double n = static_cast<long double>(nrBits);
+
+	/*	Probability that the syndrome of the flips is zero, the average over the parity checks of the
+	 *	bias of a single flip to the power of the number of flips.	*/
+	long double zeroSyndrome = 0, largestTerm = 0;
+	for (uint64_t w = 0; w <= nrBits; w++) {
+		if (dualWeights[w] > 0) {
+			const long double term = dualWeights[w] * std::pow(1.0L - 2.0L * w / n, static_cast<int>(nrBitError));
+			zeroSyndrome += term;
+			largestTerm = std::max(largestTerm, std::fabs(term));
+		}
+	}
+	zeroSyndrome = std::ldexp(zeroSyndrome, -static_cast<int>(width));
+	largestTerm = std::ldexp(largestTerm, -static_cast<int>(width));
+
+	/*	Probability that the flips cancel each other, every bit flipped an even number of times. That is
+	 *	b! [y^b] cosh(y / n)^n, the power series is raised to the n-th power truncated to degree b.	*/
+	long double emptyPattern = 0;
+	if (nrBitError % 2 == 0) {
+		const unsigned int degree = nrBitError;
+		std::vector<long double> base(degree + 1, 0), power(degree + 1, 0), product(degree + 1);
+		long double coefficient = 1;
+		for (unsigned int k = 0; k <= degree; k += 2) {
+			base[k] = coefficient;
+			coefficient /= (k + 1.0L) * (k + 2.0L) * n * n;
+		}
+		power[0] = 1;
+
+		const auto multiply = [&](std::vector<long double> &out, const std::vector<long double> &a,
+								  const std::vector<long double> &b) {
+			std::fill(product.begin(), product.end(), 0.0L);
+			for (unsigned int i = 0; i <= degree; i += 2) {
+				for (unsigned int j = 0; i + j <= degree; j += 2) {
+					product[i + j] += a[i] * b[j];
+				}
+			}
+			out = product;
+		};
+		for (uint64_t exponent = nrBits; exponent > 0; exponent /= 2) {
+			if (exponent & 1) {
+				multiply(power, power, base);
+			}
+			multiply(base, base, base);
+		}
+
+		emptyPattern = power[degree];
+		for (unsigned int k = 2; k <= degree; k++) {
+			emptyPattern *= k;
+		}
+	}
+
+	return roundCancelled(zeroSyndrome - emptyPattern, std::max(largestTerm, emptyPattern));
+}
+
+long double computeUndetectedWeightFraction(const std::vector<uint64_t> &dualWeights, unsigned int width,
+											unsigned int weight) {
+	const uint64_t nrBits = dualWeights.size() - 1;
+	if (weight == 0 || weight > nrBits) {
+		return 0;
+	}
+	const long double n = static_cast<long double>(nrBits);
+
+	/*	Krawtchouk polynomials normalized by C(n, k), Q_k(w) = K_k(w) / C(n, k), which stay within [-1, 1].	*/
+	long double fraction = 0, largestTerm = 0;
+	for (uint64_t w = 0; w <= nrBits; w++) {
+		if (dualWeights[w] == 0) {
+			continue;
+		}
+		long double previous = 1;
+		long double current = 1.0L - 2.0L * w / n;
+		for (unsigned int k = 1; k < weight; k++) {
+			const long double next = ((n - 2.0L * w) * current - k * previous) / (n - k);
+			previous = current;
+			current = next;
+		}
+		fraction += dualWeights[w] * current;
+		largestTerm = std::max(largestTerm, std::fabs(dualWeights[w] * current));
+	}
+
+	return roundCancelled(std::ldexp(fraction, -static_cast<int>(width)),
+						  std::ldexp(largestTerm, -static_cast<int>(width)));
+}
+
+long double computeUndetectedBER(const std::vector<uint64_t> &dualWeights, unsigned int width, double ber) {
+	const uint64_t nrBits = dualWeights.size() - 1;
+	const long double p = ber;
+
+	/*	Sum over the dual codewords of (1 - 2p)^w, minus the error-free outcome (1 - p)^n. Every term is
+	 *	taken as the difference to (1 - p)^n, which keeps the precision for small rates.	*/
+	const long double logNoError = nrBits * std::log1p(-p);
+	long double probability = 0;
+	for (uint64_t w = 0; w <= nrBits; w++) {
+		if (dualWeights[w] == 0) {
+			continue;
+		}
+		long double term;
+		if (p < 0.5L) {
+			term = std::exp(logNoError) * std::expm1(w * std::log1p(-2.0L * p) - logNoError);
+		} else {
+			term = std::pow(1.0L - 2.0L * p, static_cast<long double>(w)) - std::exp(logNoError);
+		}
+		probability += dualWeights[w] * term;
+	}
+
+	return std::max(0.0L, std::ldexp(probability, -static_cast<int>(width)));
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * Largest CRC width supported by the analytic mode, the dual code has up to 2^width codewords.
+ */
+static constexpr unsigned int analyticMaxWidth = 24;
+static constexpr unsigned int analyticDefaultMaxWeight = 8;
+
+/**
+ * Weight distribution of the dual of the code made of the undetected error patterns, the code whose parity
+ * check matrix has the per-bit syndromes as columns. Entry w holds the number of the 2^width parity checks
+ * u, the parity of u & syndrome, that are odd for exactly w bits of the message. Computed with a Walsh-Hadamard
+ * transform of the syndrome multiplicities, distributed over the marl scheduler bound to the calling thread.
+ */
+extern std::vector<uint64_t> computeDualWeightDistribution(const std::vector<uint64_t> &syndromes, unsigned int width);
+
+/**
+ * Probability that nrBitError uniformly random bit flips change the message without changing the CRC. Flipping
+ * the same bit twice cancels, the same error model as the sampling.
+ */
+extern long double computeUndetectedRandomFlips(const std::vector<uint64_t> &dualWeights, unsigned int width,
+												unsigned int nrBitError);
+
+/**
+ * Fraction of the error patterns of the given weight that are not detected, A_weight / C(n, weight), with the
+ * weight distribution A of the code obtained from the dual by the MacWilliams identity.
+ */
+extern long double computeUndetectedWeightFraction(const std::vector<uint64_t> &dualWeights, unsigned int width,
+												   unsigned int weight);
+
+/**
+ * Probability of an undetected error when every bit of the message is flipped independently with probability ber.
+ */
+extern long double computeUndetectedBER(const std::vector<uint64_t> &dualWeights, unsigned int width, double ber);
@@ -0,0 +1,355 @@
+#include "CRCAlgorithm.h"
+#include "CRCProfile.h"
+#include "CRCSweep.h"
+#include "RandGenerator.h"
+#include "marl/defer.h"
+#include "marl/scheduler.h"
+#include "marl/waitgroup.h"
+#include "revision.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxopts.hpp>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * Throughput of a kernel implementation of an algorithm on messages of a size, hashed by a number of threads.
+ */
+struct BenchResult {
+	std::string algorithm;
+	std::string kernel;
+	uint64_t messageSize; /*	In bytes.	*/
+	uint32_t nrThreads;
+	double bytesPerSecond; /*	Of all the threads together.	*/
+	double cyclesPerByte; /*	Of a single thread, in profile clock ticks.	*/
+};
+
+/*	Calls between the clock checks of a measurement, about this many bytes apart.	*/
+static constexpr uint64_t benchCheckBytes = 1 << 16;
+
+/*	Keeps the checksums alive, so that the hashing is not optimized away.	*/
+static volatile uint64_t benchSink;
+
+/**
+ * Hash the message over and over until the deadline. Returns the number of bytes hashed.
+ */
+template <typename Kernel>
+static uint64_t hashUntil(const std::vector<uint8_t> &message, std::chrono::steady_clock::time_point deadline) {
+	const uint64_t nrCalls = std::max<uint64_t>(1, benchCheckBytes / message.size());
+	uint64_t nrBytes = 0, sink = 0;
+	do {
+		for (uint64_t i = 0; i < nrCalls; i++) {
+			sink ^= Kernel::compute(message.data(), message.size());
+		}
+		nrBytes += nrCalls * message.size();
+	} while (std::chrono::steady_clock::now() < deadline);
+	benchSink = benchSink ^ sink;
+	return nrBytes;
+}
+
+/**
+ * Measure the throughput of the selected implementation of the kernel, on one message per thread for at least
+ * seconds. Every thread hashes its own message, the threads run as tasks on the bound marl scheduler.
+ */
+template <typename Kernel>
+static BenchResult measureKernel(std::vector<std::vector<uint8_t>> &messages, uint32_t nrThreads, double seconds) {
+	/*	Warm the caches and the branch predictors.	*/
+	for (uint32_t i = 0; i < nrThreads; i++) {
+		benchSink = benchSink ^ Kernel::compute(messages[i].data(), messages[i].size());
+	}
+
+	std::vector<uint64_t> nrBytes(nrThreads, 0);
+	const auto start = std::chrono::steady_clock::now();
+	const uint64_t startTicks = readProfileTicks();
+	const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+									  std::chrono::duration<double>(seconds));
+	if (nrThreads == 1) {
+		nrBytes[0] = hashUntil<Kernel>(messages[0], deadline);
+	} else {
+		marl::WaitGroup tasksDone(nrThreads);
+		for (uint32_t i = 0; i < nrThreads; i++) {
+			marl::schedule([&, i] {
+				defer(tasksDone.done());
+				nrBytes[i] = hashUntil<Kernel>(messages[i], deadline);
+			});
+		}
+		tasksDone.wait();
+	}
+	const uint64_t elapsedTicks = readProfileTicks() - startTicks;
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint64_t totalBytes = 0;
+	for (const uint64_t bytes : nrBytes) {
+		totalBytes += bytes;
+	}
+	BenchResult result;
+	result.messageSize = messages[0].size();
+	result.nrThreads = nrThreads;
+	result.bytesPerSecond = (double)totalBytes / elapsed;
+	result.cyclesPerByte = (double)elapsedTicks * nrThreads / (double)totalBytes;
+	return result;
+}
+
+/*	Value of a key of a flat JSON object on a single line, without the quotes of a string.	*/
+static bool findJSONValue(const std::string &line, const std::string &key, std::string &value) {
+	const std::string pattern = "\"" + key + "\":";
+	size_t begin = line.find(pattern);
+	if (begin == std::string::npos) {
+		return false;
+	}
+	begin += pattern.size();
+	if (begin < line.size() && line[begin] == '"') {
+		const size_t end = line.find('"', begin + 1);
+		if (end == std::string::npos) {
+			return false;
+		}
+		value = line.substr(begin + 1, end - begin - 1);
+	} else {
+		value = line.substr(begin, line.find_first_of(",}", begin) - begin);
+	}
+	return true;
+}
+
+/**
+ * Read the results of a benchmark written with --output. Returns false if the file can not be opened, throws
+ * std::invalid_argument if a result is incomplete.
+ */
+static bool readBenchResults(const std::string &path, std::vector<BenchResult> &results) {
+	std::ifstream file(path);
+	if (!file) {
+		return false;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.compare(0, 13, "{\"algorithm\":") != 0) {
+			continue;
+		}
+		std::string size, threads, bytesPerSecond, cyclesPerByte;
+		BenchResult result;
+		if (!findJSONValue(line, "algorithm", result.algorithm) || !findJSONValue(line, "kernel", result.kernel) ||
+			!findJSONValue(line, "size", size) || !findJSONValue(line, "threads", threads) ||
+			!findJSONValue(line, "bytes_per_sec", bytesPerSecond) ||
+			!findJSONValue(line, "cycles_per_byte", cyclesPerByte)) {
+			throw std::invalid_argument("Malformed benchmark results " + path);
+		}
+		result.messageSize = std::stoull(size);
+		result.nrThreads = static_cast<uint32_t>(std::stoul(threads));
+		result.bytesPerSecond = std::stod(bytesPerSecond);
+		result.cyclesPerByte = std::stod(cyclesPerByte);
+		results.push_back(result);
+	}
+	return true;
+}
+
+static bool writeBenchResults(const std::string &path, const std::vector<BenchResult> &results) {
+	FILE *file = fopen(path.c_str(), "w");
+	if (file == nullptr) {
+		return false;
+	}
+	fprintf(file, "{\"version\":\"%s\",\"commit\":\"%s\",\"clock\":\"%s\",\"results\":[\n", CRC_ANALYSIS_STR,
+			CRC_ANALYSIS_GITCOMMIT_STR, profileTickName);
+	for (size_t i = 0; i < results.size(); i++) {
+		const BenchResult &result = results[i];
+		fprintf(file,
+				"{\"algorithm\":\"%s\",\"kernel\":\"%s\",\"size\":%lu,\"threads\":%u,\"bytes_per_sec\":%.6e,"
+				"\"cycles_per_byte\":%.6e}%s\n",
+				result.algorithm.c_str(), result.kernel.c_str(), (unsigned long)result.messageSize, result.nrThreads,
+				result.bytesPerSecond, result.cyclesPerByte, i + 1 < results.size() ? "," : "");
+	}
+	fputs("]}\n", file);
+	const bool written = !ferror(file);
+	return fclose(file) == 0 && written;
+}
+
+/**
+ * Print the results slower than their baseline by more than the threshold, a fraction of the baseline
+ * throughput. Results without a baseline are skipped. Returns the number of regressions.
+ */
+static unsigned int compareBenchResults(const std::vector<BenchResult> &results,
+										const std::vector<BenchResult> &baseline, double threshold) {
+	using BenchKey = std::tuple<std::string, std::string, uint64_t, uint32_t>;
+	std::map<BenchKey, double> baselineThroughput;
+	for (const BenchResult &result : baseline) {
+		baselineThroughput[BenchKey(result.algorithm, result.kernel, result.messageSize, result.nrThreads)] =
+			result.bytesPerSecond;
+	}
+
+	unsigned int nrCompared = 0, nrRegressions = 0;
+	for (const BenchResult &result : results) {
+		const auto found =
+			baselineThroughput.find(BenchKey(result.algorithm, result.kernel, result.messageSize, result.nrThreads));
+		if (found == baselineThroughput.end()) {
+			continue;
+		}
+		nrCompared++;
+		if (result.bytesPerSecond < found->second * (1 - threshold)) {
+			printf("Regression: %s %s, %lu B, %u threads: %.3f MB/s, baseline %.3f MB/s (%+.1f%%)\n",
+				   result.algorithm.c_str(), result.kernel.c_str(), (unsigned long)result.messageSize,
+				   result.nrThreads, result.bytesPerSecond * 1e-6, found->second * 1e-6,
+				   100.0 * (result.bytesPerSecond / found->second - 1));
+			nrRegressions++;
+		}
+	}
+	printf("%u of %u results compared with the baseline regressed by more than %.1f%%\n", nrRegressions,
+		   nrCompared, 100.0 * threshold);
+	return nrRegressions;
+}
+
+int main(int argc, const char **argv) {
+	try {
+		cxxopts::Options options("CRCBench", "Throughput of the CRC kernels");
+		options.add_options()("h,help", "helper information.")(
+			"c,crc", "CRC Algorithm, a comma separated list or all.",
+			cxxopts::value<std::string>()->default_value("all"))(
+			"k,kernel", "Kernel implementation to measure, every supported one by default.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"sizes", "Message sizes in bytes, a range such as 4..16777216:x4.",
+			cxxopts::value<std::string>()->default_value("4..16777216:x4"))(
+			"min-time", "Seconds every measurement runs for.", cxxopts::value<double>()->default_value("0.05"))(
+			"threads", "Number of threads of the all-cores measurements, all cores by default (1 disabled).",
+			cxxopts::value<uint32_t>()->default_value("0"))(
+			"o,output", "Write the results as JSON to this file.", cxxopts::value<std::string>()->default_value(""))(
+			"compare", "Baseline results written with --output, the slower results are reported as regressions.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"threshold", "Relative slowdown from the baseline reported as a regression.",
+			cxxopts::value<double>()->default_value("0.05"));
+
+		auto result = options.parse(argc, (char **&)argv);
+		if (result.count("help") > 0) {
+			std::cout << options.help();
+			return EXIT_SUCCESS;
+		}
+
+		std::vector<std::string> crcNames;
+		const std::string &crcStr = result["crc"].as<std::string>();
+		if (crcStr == "all") {
+			for (const auto &entry : crcAlgorithmTable) {
+				if (entry.first != customCRCName) {
+					crcNames.push_back(entry.first);
+				}
+			}
+			std::sort(crcNames.begin(), crcNames.end());
+		} else {
+			size_t begin = 0;
+			while (begin <= crcStr.size()) {
+				const size_t end = std::min(crcStr.find(',', begin), crcStr.size());
+				const std::string name = crcStr.substr(begin, end - begin);
+				if (crcAlgorithmTable.find(name) == crcAlgorithmTable.end() || name == customCRCName) {
+					std::cerr << "Invalid CRC Options " << name << std::endl;
+					return EXIT_FAILURE;
+				}
+				crcNames.push_back(name);
+				begin = end + 1;
+			}
+		}
+
+		std::vector<CRCImplementation> implementations(std::begin(allCRCImplementations),
+													   std::end(allCRCImplementations));
+		const std::string &kernelStr = result["kernel"].as<std::string>();
+		if (!kernelStr.empty()) {
+			implementations.resize(1);
+			if (!parseCRCImplementation(kernelStr, implementations.front())) {
+				std::cerr << "Invalid kernel " << kernelStr << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		std::vector<uint64_t> messageSizes;
+		for (const double size : parseSweepRange("sizes", result["sizes"].as<std::string>())) {
+			if (size < 1) {
+				std::cerr << "Message sizes must be positive" << std::endl;
+				return EXIT_FAILURE;
+			}
+			messageSizes.push_back(static_cast<uint64_t>(size));
+		}
+		const double seconds = result["min-time"].as<double>();
+		const double threshold = result["threshold"].as<double>();
+		if (!(seconds > 0) || !(threshold >= 0 && threshold < 1)) {
+			std::cerr << "Minimum time must be positive and the threshold within [0, 1)" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::vector<BenchResult> baseline;
+		const std::string &baselinePath = result["compare"].as<std::string>();
+		if (!baselinePath.empty() && !readBenchResults(baselinePath, baseline)) {
+			std::cerr << "Failed to open " << baselinePath << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		marl::Scheduler::Config schedulerConfig = marl::Scheduler::Config::allCores();
+		if (result["threads"].as<uint32_t>() > 0) {
+			schedulerConfig.setWorkerThreadCount(result["threads"].as<uint32_t>());
+		}
+		marl::Scheduler scheduler(schedulerConfig);
+		scheduler.bind();
+		defer(scheduler.unbind());
+
+		/*	A single thread, and every worker thread at once.	*/
+		std::vector<uint32_t> threadCounts = {1};
+		const uint32_t nrWorkers = static_cast<uint32_t>(scheduler.config().workerThread.count);
+		if (nrWorkers > 1) {
+			threadCounts.push_back(nrWorkers);
+		}
+
+		/*	Random messages, one per thread, the largest size is shared by all the smaller ones.	*/
+		PCGRandom randGen(std::random_device{}(), 0);
+		std::vector<std::vector<uint8_t>> messages(threadCounts.back());
+		std::vector<uint8_t> data(*std::max_element(messageSizes.begin(), messageSizes.end()));
+		for (uint8_t &value : data) {
+			value = static_cast<uint8_t>(randGen.getRandom());
+		}
+
+		printf("%-16s %-14s %10s %8s %14s %14s\n", "algorithm", "kernel", "size", "threads", "MB/s",
+			   (std::string(profileTickName) + "/B").c_str());
+		std::vector<BenchResult> results;
+		for (const std::string &crcName : crcNames) {
+			dispatchCRCAlgorithm(crcAlgorithmTable.at(crcName), [&](auto kernel) {
+				using Kernel = decltype(kernel);
+				const CRCImplementation previous = Kernel::implementation;
+				for (const CRCImplementation implementation : implementations) {
+					if (!Kernel::isImplementationSupported(implementation)) {
+						continue;
+					}
+					Kernel::setImplementation(implementation);
+
+					for (const uint64_t messageSize : messageSizes) {
+						for (std::vector<uint8_t> &message : messages) {
+							message.assign(data.begin(), data.begin() + messageSize);
+						}
+						for (const uint32_t nrThreads : threadCounts) {
+							BenchResult measured = measureKernel<Kernel>(messages, nrThreads, seconds);
+							measured.algorithm = crcName;
+							measured.kernel = getCRCImplementationName(implementation);
+							printf("%-16s %-14s %10lu %8u %14.3f %14.4f\n", crcName.c_str(), measured.kernel.c_str(),
+								   (unsigned long)messageSize, nrThreads, measured.bytesPerSecond * 1e-6,
+								   measured.cyclesPerByte);
+							fflush(stdout);
+							results.push_back(measured);
+						}
+					}
+				}
+				Kernel::setImplementation(previous);
+			});
+		}
+
+		const std::string &outputPath = result["output"].as<std::string>();
+		if (!outputPath.empty() && !writeBenchResults(outputPath, results)) {
+			std::cerr << "Failed to write " << outputPath << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (!baselinePath.empty() && compareBenchResults(results, baseline, threshold) > 0) {
+			return EXIT_FAILURE;
+		}
+	} catch (const std::exception &ex) {
+		std::cerr << ex.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+#include "CRCBurst.h"
+#include "marl/defer.h"
+#include "marl/scheduler.h"
+#include "marl/waitgroup.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+/*	Number of burst patterns claimed at a time by the enumeration tasks.	*/
+static constexpr uint64_t burstPatternBlockSize = 1024;
+
+BurstSyndromes::BurstSyndromes(const std::vector<uint64_t> &syndromes) {
+	/*	Reflected CRCs consume the bits LSB first, the others MSB first, i.e. with the bit index within the byte
+	 *	mirrored. Checksums invariant in neither keep the bit order.	*/
+	for (const uint32_t bitOrderMask : {0u, 7u}) {
+		columns.resize(syndromes.size());
+		for (size_t i = 0; i < syndromes.size(); i++) {
+			columns[i] = syndromes[i ^ bitOrderMask];
+		}
+		if (deriveShift()) {
+			shiftInvariant = true;
+			return;
+		}
+	}
+	columns = syndromes;
+}
+
+bool BurstSyndromes::deriveShift() {
+	/*	Echelon basis of the columns, each with the column of the next position. The map is consistent if
+	 *	every column depending on the others moves to the same combination of the next columns.	*/
+	uint64_t basis[64] = {0}, images[64] = {0};
+	for (size_t p = 0; p + 1 < columns.size(); p++) {
+		uint64_t vector = columns[p], image = columns[p + 1];
+		for (int bit = 63; bit >= 0 && vector != 0; bit--) {
+			if (((vector >> bit) & 1) == 0) {
+				continue;
+			}
+			if (basis[bit] == 0) {
+				basis[bit] = vector;
+				images[bit] = image;
+				vector = 0;
+				image = 0;
+				break;
+			}
+			vector ^= basis[bit];
+			image ^= images[bit];
+		}
+		if (image != 0) {
+			return false;
+		}
+	}
+
+	/*	Tabulate the map per byte, the bits outside the span of the columns are dropped.	*/
+	uint64_t syndromeBits = 0;
+	for (const uint64_t column : columns) {
+		syndromeBits |= column;
+	}
+	nrShiftBytes = 0;
+	while (nrShiftBytes < 8 && (syndromeBits >> (nrShiftBytes * 8)) != 0) {
+		nrShiftBytes++;
+	}
+	for (unsigned int i = 0; i < nrShiftBytes; i++) {
+		for (unsigned int value = 0; value < 256; value++) {
+			uint64_t vector = static_cast<uint64_t>(value) << (i * 8), image = 0;
+			for (int bit = 63; bit >= 0; bit--) {
+				if (((vector >> bit) & 1) != 0 && basis[bit] != 0) {
+					vector ^= basis[bit];
+					image ^= images[bit];
+				}
+			}
+			shiftTable[i][value] = image;
+		}
+	}
+	return true;
+}
+
+/**
+ * Count the undetected bursts of the given length for nrPatterns patterns from firstPattern, in Gray code
+ * order of the bits between the first and last, so that each pattern differs from the previous by one bit.
+ */
+static uint64_t countUndetectedBursts(const BurstSyndromes &syndromes, unsigned int length, uint64_t firstPattern,
+									  uint64_t nrPatterns) {
+	const std::vector<uint64_t> &columns = syndromes.getColumns();
+	const size_t nrPositions = columns.size() - length + 1;
+	const unsigned int last = length - 1;
+
+	/*	Syndrome of the pattern at the first position.	*/
+	uint64_t gray = firstPattern ^ (firstPattern >> 1);
+	uint64_t syndrome = columns[0] ^ (length > 1 ? columns[last] : 0);
+	for (unsigned int k = 0; k + 2 < length; k++) {
+		if ((gray >> k) & 1) {
+			syndrome ^= columns[1 + k];
+		}
+	}
+
+	uint64_t nrUndetected = 0;
+	for (uint64_t i = firstPattern; i < firstPattern + nrPatterns; i++) {
+		if (syndromes.isShiftInvariant()) {
+			uint64_t moved = syndrome;
+			for (size_t position = 0; position < nrPositions; position++) {
+				nrUndetected += moved == 0;
+				moved = syndromes.shift(moved);
+			}
+		} else {
+			/*	Without a shift every position sums its own columns.	*/
+			gray = i ^ (i >> 1);
+			for (size_t position = 0; position < nrPositions; position++) {
+				uint64_t moved = columns[position] ^ (length > 1 ? columns[position + last] : 0);
+				for (unsigned int k = 0; k + 2 < length; k++) {
+					if ((gray >> k) & 1) {
+						moved ^= columns[position + 1 + k];
+					}
+				}
+				nrUndetected += moved == 0;
+			}
+		}
+
+		/*	The next Gray code flips the lowest set bit of i + 1.	*/
+		if (length > 2 && i + 1 < getNrBurstPatterns(length)) {
+			syndrome ^= columns[1 + __builtin_ctzll(i + 1)];
+		}
+	}
+	return nrUndetected;
+}
+
+std::vector<BurstLengthResult> computeBurstUndetected(const BurstSyndromes &syndromes, unsigned int maxLength) {
+	const uint64_t nrBits = syndromes.getColumns().size();
+	assert(maxLength >= 1 && maxLength <= burstMaxExhaustiveLength && maxLength <= nrBits);
+
+	/*	The blocks of every length are claimed from a single cursor, longest first as they have the most. Block b
+	 *	belongs to the i-th longest length with firstBlocks[i] <= b < firstBlocks[i + 1].	*/
+	std::vector<uint64_t> firstBlocks(1, 0);
+	for (unsigned int length = maxLength; length >= 1; length--) {
+		const uint64_t nrBlocks = (getNrBurstPatterns(length) + burstPatternBlockSize - 1) / burstPatternBlockSize;
+		firstBlocks.push_back(firstBlocks.back() + nrBlocks);
+	}
+	const uint64_t nrBlocks = firstBlocks.back();
+
+	std::vector<std::atomic_uint64_t> nrUndetected(maxLength + 1);
+	for (std::atomic_uint64_t &count : nrUndetected) {
+		count.store(0, std::memory_order_relaxed);
+	}
+	std::atomic_uint64_t cursor{0};
+
+	const uint32_t nrWorkers = std::max<uint32_t>(1, marl::Scheduler::get()->config().workerThread.count);
+	marl::WaitGroup wg(nrWorkers);
+	for (uint32_t w = 0; w < nrWorkers; w++) {
+		marl::schedule([&] {
+			defer(wg.done());
+			for (uint64_t b = cursor.fetch_add(1, std::memory_order_relaxed); b < nrBlocks;
+				 b = cursor.fetch_add(1, std::memory_order_relaxed)) {
+				const size_t i = std::upper_bound(firstBlocks.begin(), firstBlocks.end(), b) - firstBlocks.begin() - 1;
+				const unsigned int length = maxLength - static_cast<unsigned int>(i);
+				const uint64_t firstPattern = (b - firstBlocks[i]) * burstPatternBlockSize;
+				const uint64_t nrPatterns = std::min(burstPatternBlockSize, getNrBurstPatterns(length) - firstPattern);
+				nrUndetected[length].fetch_add(countUndetectedBursts(syndromes, length, firstPattern, nrPatterns),
+											   std::memory_order_relaxed);
+			}
+		});
+	}
+	wg.wait();
+
+	std::vector<BurstLengthResult> results;
+	for (unsigned int length = 1; length <= maxLength; length++) {
+		results.push_back({length, getNrBurstPatterns(length) * (nrBits - length + 1), nrUndetected[length].load()});
+	}
+	return results;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/*	Longest burst of the random burst errors, and of the exhaustive enumeration, whose cost doubles per bit.	*/
+static constexpr unsigned int burstMaxLength = 64;
+static constexpr unsigned int burstMaxExhaustiveLength = 40;
+
+/**
+ * Exact number of undetected bursts of a single length.
+ */
+struct BurstLengthResult {
+	unsigned int length;
+	uint64_t nrBursts;
+	uint64_t nrUndetected;
+};
+
+/**
+ * Per-bit syndromes in the order the bits are transmitted, and the update of a syndrome when its error moves
+ * one bit later. The bits of each byte are sent LSB first for reflected CRCs and MSB first otherwise, the order
+ * is the one in which moving an error is the same linear map at every position, derived from the syndromes.
+ */
+class BurstSyndromes {
+  public:
+	explicit BurstSyndromes(const std::vector<uint64_t> &syndromes);
+
+	/**
+	 * Syndrome of the bit at each transmitted position.
+	 */
+	const std::vector<uint64_t> &getColumns() const noexcept { return columns; }
+
+	/**
+	 * Whether moving an error one bit is the same linear map everywhere, false for checksums without such an
+	 * order, where shift can not be used.
+	 */
+	bool isShiftInvariant() const noexcept { return shiftInvariant; }
+
+	/**
+	 * Syndrome of the error moved one bit later, a lookup per byte of the syndrome.
+	 */
+	uint64_t shift(uint64_t syndrome) const noexcept {
+		uint64_t shifted = 0;
+		for (unsigned int i = 0; i < nrShiftBytes; i++) {
+			shifted ^= shiftTable[i][(syndrome >> (i * 8)) & 0xFF];
+		}
+		return shifted;
+	}
+
+  private:
+	bool deriveShift();
+
+	std::vector<uint64_t> columns;
+	bool shiftInvariant = false;
+	unsigned int nrShiftBytes = 0;
+	uint64_t shiftTable[8][256];
+};
+
+/**
+ * Number of bursts of exactly length bits at a single position, the first and last bit flipped and
+ * every combination of the bits in between.
+ */
+static inline uint64_t getNrBurstPatterns(unsigned int length) noexcept {
+	return length < 2 ? 1 : static_cast<uint64_t>(1) << (length - 2);
+}
+
+/**
+ * Enumerate every burst of length 1 to maxLength at every position of the message and count those whose
+ * syndrome is zero, i.e. not detected. Every pattern is slid over the message with the shift of the syndromes,
+ * so moving it a bit costs a few table lookups instead of rehashing. Distributed over the marl scheduler bound
+ * to the calling thread.
+ */
+extern std::vector<BurstLengthResult> computeBurstUndetected(const BurstSyndromes &syndromes, unsigned int maxLength);
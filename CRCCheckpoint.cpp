@@ -0,0 +1,121 @@
+#include "CRCCheckpoint.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+/*	Identifies the file and the version of its layout, the integers follow in the byte order of the host.	*/
+static const char sampleCheckpointMagic[8] = {'C', 'R', 'C', 'S', 'C', 'K', 'P', '2'};
+
+/*	Largest specification and counter vector accepted when reading, guarding against allocating for a corrupted
+ *	length.	*/
+static constexpr uint64_t sampleCheckpointMaxSpecSize = 65536;
+static constexpr uint64_t sampleCheckpointMaxCounters = static_cast<uint64_t>(1) << 32;
+
+static std::atomic_bool terminationRequested{false};
+
+static bool writeUInt64(FILE *file, uint64_t value) { return fwrite(&value, sizeof(value), 1, file) == 1; }
+
+static bool readUInt64(FILE *file, uint64_t &value) { return fread(&value, sizeof(value), 1, file) == 1; }
+
+/*	Doubles are stored as the bits of their host representation.	*/
+static bool writeDouble(FILE *file, double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return writeUInt64(file, bits);
+}
+
+static bool readDouble(FILE *file, double &value) {
+	uint64_t bits;
+	if (!readUInt64(file, bits)) {
+		return false;
+	}
+	memcpy(&value, &bits, sizeof(value));
+	return true;
+}
+
+/*	Flush the directory entry of the path to the disk, so that a rename into it survives a crash.	*/
+static bool syncParentDirectory(const std::string &path) {
+	const size_t separator = path.find_last_of('/');
+	const std::string directory =
+		separator == std::string::npos ? "." : separator == 0 ? "/" : path.substr(0, separator);
+	const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0) {
+		return false;
+	}
+	const bool synced = fsync(fd) == 0;
+	close(fd);
+	return synced;
+}
+
+bool replaceCheckpointFile(FILE *file, bool written, const std::string &temporaryPath, const std::string &path) {
+	/*	The data must be on the disk before the rename, or a crash could leave an empty checkpoint in place of the
+	 *	previous one.	*/
+	written = written && fflush(file) == 0 && !ferror(file) && fsync(fileno(file)) == 0;
+	written = fclose(file) == 0 && written;
+	return written && std::rename(temporaryPath.c_str(), path.c_str()) == 0 && syncParentDirectory(path);
+}
+
+bool writeSampleCheckpoint(const std::string &path, const SampleCheckpoint &checkpoint) {
+	const std::string temporaryPath = path + ".tmp";
+	FILE *file = fopen(temporaryPath.c_str(), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+
+	bool written = fwrite(sampleCheckpointMagic, sizeof(sampleCheckpointMagic), 1, file) == 1 &&
+				   writeUInt64(file, checkpoint.spec.size()) &&
+				   fwrite(checkpoint.spec.data(), 1, checkpoint.spec.size(), file) == checkpoint.spec.size() &&
+				   writeUInt64(file, checkpoint.seed) && writeUInt64(file, checkpoint.nthRun) &&
+				   writeUInt64(file, checkpoint.nextBlock) && writeUInt64(file, checkpoint.nrSamples) &&
+				   writeDouble(file, checkpoint.wallTime) && writeUInt64(file, checkpoint.nrCollisions.size());
+	if (written && !checkpoint.nrCollisions.empty()) {
+		written = fwrite(checkpoint.nrCollisions.data(), sizeof(uint64_t), checkpoint.nrCollisions.size(), file) ==
+				  checkpoint.nrCollisions.size();
+	}
+
+	return replaceCheckpointFile(file, written, temporaryPath, path);
+}
+
+bool readSampleCheckpoint(const std::string &path, SampleCheckpoint &checkpoint) {
+	FILE *file = fopen(path.c_str(), "rb");
+	if (file == nullptr) {
+		return false;
+	}
+
+	char magic[sizeof(sampleCheckpointMagic)];
+	uint64_t specSize = 0, nrCounters = 0;
+	bool complete = fread(magic, sizeof(magic), 1, file) == 1 &&
+					memcmp(magic, sampleCheckpointMagic, sizeof(magic)) == 0 && readUInt64(file, specSize) &&
+					specSize <= sampleCheckpointMaxSpecSize;
+	if (complete) {
+		checkpoint.spec.resize(specSize);
+		complete = fread(&checkpoint.spec[0], 1, specSize, file) == specSize && readUInt64(file, checkpoint.seed) &&
+				   readUInt64(file, checkpoint.nthRun) && readUInt64(file, checkpoint.nextBlock) &&
+				   readUInt64(file, checkpoint.nrSamples) && readDouble(file, checkpoint.wallTime) &&
+				   readUInt64(file, nrCounters) && nrCounters <= sampleCheckpointMaxCounters;
+	}
+	if (complete) {
+		checkpoint.nrCollisions.resize(nrCounters);
+		complete = fread(checkpoint.nrCollisions.data(), sizeof(uint64_t), nrCounters, file) == nrCounters &&
+				   fgetc(file) == EOF;
+	}
+	fclose(file);
+
+	if (!complete) {
+		throw std::invalid_argument("Malformed checkpoint " + path);
+	}
+	return true;
+}
+
+static void requestTermination(int) { terminationRequested.store(true, std::memory_order_relaxed); }
+
+void installTerminationHandler() {
+	std::signal(SIGTERM, requestTermination);
+	std::signal(SIGINT, requestTermination);
+}
+
+bool isTerminationRequested() noexcept { return terminationRequested.load(std::memory_order_relaxed); }
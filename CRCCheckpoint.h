@@ -0,0 +1,75 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*	Interval between the checkpoints of a long run.	*/
+static constexpr std::chrono::seconds checkpointInterval(10);
+
+/**
+ * Progress of a sampling run, --forever included. The random streams of a sample block only depend on the seed and
+ * the index of the block, so the stream positions are the runs completed and the blocks of the current run that
+ * were all sampled. The collisions are counted over every sampled block, one counter per algorithm, times every
+ * bit error count and cell of a sweep.
+ */
+struct SampleCheckpoint {
+	std::string spec; /*	Canonical parameters of the run, a checkpoint only continues the same run.	*/
+	uint64_t seed = 0;
+	uint64_t nthRun = 0;
+	uint64_t nextBlock = 0; /*	Every block of the current run before it has been sampled.	*/
+	uint64_t nrSamples = 0;
+	double wallTime = 0; /*	Seconds spent sampling, over every process of the run.	*/
+	std::vector<uint64_t> nrCollisions;
+};
+
+/**
+ * Close the temporary file a checkpoint was written to and rename it over the path, the file and then its directory
+ * synced to the disk. written is whether every write to the file succeeded. The file is closed in every case.
+ */
+extern bool replaceCheckpointFile(FILE *file, bool written, const std::string &temporaryPath, const std::string &path);
+
+/**
+ * Write the checkpoint in binary, replacing the file atomically so that a run killed while writing keeps the
+ * previous checkpoint.
+ */
+extern bool writeSampleCheckpoint(const std::string &path, const SampleCheckpoint &checkpoint);
+
+/**
+ * Read a checkpoint. Returns false if the file can not be opened, throws std::invalid_argument if it is not a
+ * complete checkpoint.
+ */
+extern bool readSampleCheckpoint(const std::string &path, SampleCheckpoint &checkpoint);
+
+/**
+ * Save the progress and stop on SIGTERM or SIGINT, instead of terminating right away.
+ */
+extern void installTerminationHandler();
+
+/**
+ * Whether a termination signal arrived since the handler was installed.
+ */
+extern bool isTerminationRequested() noexcept;
+
+/**
+ * Decides when a run saves its progress, at every checkpoint interval and when asked to terminate. A disabled
+ * clock is never due.
+ */
+class CheckpointClock {
+  public:
+	explicit CheckpointClock(bool enabled = false) : enabled(enabled), last(std::chrono::steady_clock::now()) {}
+
+	bool isEnabled() const noexcept { return enabled; }
+
+	bool isDue() const noexcept {
+		return enabled &&
+			   (isTerminationRequested() || std::chrono::steady_clock::now() - last >= checkpointInterval);
+	}
+
+	void restart() noexcept { last = std::chrono::steady_clock::now(); }
+
+  private:
+	bool enabled;
+	std::chrono::steady_clock::time_point last;
+};
@@ -0,0 +1,66 @@
+#include "CRCCombine.h"
+#include "marl/scheduler.h"
+#include "marl/waitgroup.h"
+#include <algorithm>
+#include <vector>
+
+CRCShift::CRCShift() noexcept {
+	for (unsigned int bit = 0; bit < 64; bit++) {
+		columns[bit] = static_cast<uint64_t>(1) << bit;
+	}
+}
+
+CRCShift::CRCShift(const CRCShift &byteShift, uint64_t nrBytes) noexcept : CRCShift() {
+	/*	Shifts by powers of two bytes, multiplied in for the bits set in nrBytes.	*/
+	CRCShift power = byteShift;
+	while (nrBytes > 0) {
+		if (nrBytes & 1) {
+			*this = power.compose(*this);
+		}
+		nrBytes >>= 1;
+		if (nrBytes > 0) {
+			power = power.compose(power);
+		}
+	}
+}
+
+CRCShift CRCShift::compose(const CRCShift &first) const noexcept {
+	CRCShift composed;
+	for (unsigned int bit = 0; bit < 64; bit++) {
+		composed.columns[bit] = apply(first.columns[bit]);
+	}
+	return composed;
+}
+
+uint64_t ChunkedCRC::compute(const void *data) const {
+	if (nrChunks <= 1) {
+		return computeChunk(data, messageSize);
+	}
+
+	const uint8_t *p = static_cast<const uint8_t *>(data);
+	const auto getChunkSize = [&](uint64_t chunk) { return std::min(chunkSize, messageSize - chunk * chunkSize); };
+	std::vector<uint64_t> crcs(nrChunks);
+
+	if (marl::Scheduler::get() != nullptr) {
+		marl::WaitGroup chunksDone(static_cast<unsigned int>(nrChunks - 1));
+		for (uint64_t chunk = 1; chunk < nrChunks; chunk++) {
+			marl::schedule([&, chunk] {
+				crcs[chunk] = computeChunk(p + chunk * chunkSize, getChunkSize(chunk));
+				chunksDone.done();
+			});
+		}
+		crcs[0] = computeChunk(p, chunkSize);
+		chunksDone.wait();
+	} else {
+		for (uint64_t chunk = 0; chunk < nrChunks; chunk++) {
+			crcs[chunk] = computeChunk(p + chunk * chunkSize, getChunkSize(chunk));
+		}
+	}
+
+	uint64_t crc = crcs[0];
+	for (uint64_t chunk = 1; chunk < nrChunks; chunk++) {
+		const CRCShift &shift = chunk + 1 < nrChunks ? chunkShift : lastShift;
+		crc = shift.apply(crc ^ emptyCRC) ^ crcs[chunk];
+	}
+	return crc;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Appending zero bytes to a message as a linear map of its CRC value, the multiplication by x^(8 * nrBytes)
+ * mod P in the bit order of the value. Stored as the image of every bit of the value, a GF(2) matrix of at
+ * most 64 columns, so that applying it costs one XOR per set bit whatever the number of bytes.
+ */
+class CRCShift {
+  public:
+	/**
+	 * Shift by no byte, the identity.
+	 */
+	CRCShift() noexcept;
+
+	/**
+	 * Shift by nrBytes zero bytes, the square-and-multiply of the shift by a single byte in
+	 * O(width^2 log nrBytes).
+	 */
+	CRCShift(const CRCShift &byteShift, uint64_t nrBytes) noexcept;
+
+	uint64_t apply(uint64_t crc) const noexcept {
+		uint64_t shifted = 0;
+		for (unsigned int bit = 0; crc != 0; bit++, crc >>= 1) {
+			if (crc & 1) {
+				shifted ^= columns[bit];
+			}
+		}
+		return shifted;
+	}
+
+	/**
+	 * Shift by a single zero byte of the kernel. The image of every bit of the value is found by feeding a
+	 * zero byte to the register the bit comes from, which holds for any register layout and bit order.
+	 */
+	template <typename Kernel> static CRCShift createByteShift() noexcept {
+		using Register = typename Kernel::Register;
+		static constexpr uint8_t zeroByte = 0;
+
+		CRCShift byteShift;
+		for (unsigned int bit = 0; bit < sizeof(Register) * 8; bit++) {
+			const Register crc = static_cast<Register>(static_cast<Register>(1) << bit);
+			/*	Register bits outside the CRC, and the words an XOR checksum does not fill, have no image.	*/
+			const uint64_t value = static_cast<uint64_t>(Kernel::residue(crc));
+			if (value != 0 && (value & (value - 1)) == 0) {
+				byteShift.columns[countTrailingZeros(value)] =
+					static_cast<uint64_t>(Kernel::residue(Kernel::update(crc, &zeroByte, 1)));
+			}
+		}
+		return byteShift;
+	}
+
+	/**
+	 * The shift by this one after first, by the sum of their number of bytes.
+	 */
+	CRCShift compose(const CRCShift &first) const noexcept;
+
+  private:
+	static unsigned int countTrailingZeros(uint64_t value) noexcept {
+		unsigned int nrZeros = 0;
+		while ((value & 1) == 0) {
+			value >>= 1;
+			nrZeros++;
+		}
+		return nrZeros;
+	}
+
+	uint64_t columns[64];
+};
+
+/**
+ * CRC of a message too large for a single worker, split into chunks that are hashed in parallel on the bound
+ * marl scheduler and joined left to right with CRC(A || B) = shift_|B|(CRC(A) ^ CRC()) ^ CRC(B), where CRC()
+ * of the empty message carries the initial value and the final XOR that the shift must not multiply. The
+ * shifts of a whole chunk and of the last chunk are created once per message size.
+ */
+class ChunkedCRC {
+  public:
+	/**
+	 * Hash the messages serially, a single chunk.
+	 */
+	ChunkedCRC() noexcept = default;
+
+	/**
+	 * Split messages of messageSize bytes into chunks of chunkSize bytes, a multiple of 8 bytes so that the
+	 * chunks are whole words of the XOR checksums. A chunkSize of 0 or not less than the message hashes the
+	 * message serially.
+	 */
+	template <typename Kernel> static ChunkedCRC create(uint64_t messageSize, uint64_t chunkSize) noexcept {
+		ChunkedCRC chunked;
+		chunked.computeChunk = &Kernel::compute;
+		chunked.messageSize = messageSize;
+		if (chunkSize == 0 || chunkSize >= messageSize) {
+			return chunked;
+		}
+
+		chunked.chunkSize = chunkSize;
+		chunked.nrChunks = (messageSize + chunkSize - 1) / chunkSize;
+		chunked.emptyCRC = static_cast<uint64_t>(Kernel::end(Kernel::begin()));
+		const CRCShift byteShift = CRCShift::createByteShift<Kernel>();
+		chunked.chunkShift = CRCShift(byteShift, chunkSize);
+		chunked.lastShift = CRCShift(byteShift, messageSize - (chunked.nrChunks - 1) * chunkSize);
+		return chunked;
+	}
+
+	uint64_t getNrChunks() const noexcept { return nrChunks; }
+
+	/**
+	 * CRC of the message of messageSize bytes. The chunks but the first are scheduled as tasks while the
+	 * calling task hashes the first one, they are hashed in turn if no scheduler is bound.
+	 */
+	uint64_t compute(const void *data) const;
+
+  private:
+	uint64_t (*computeChunk)(const void *data, size_t size) = nullptr;
+	uint64_t messageSize = 0;
+	uint64_t chunkSize = 0;
+	uint64_t nrChunks = 1;
+	uint64_t emptyCRC = 0;
+	CRCShift chunkShift;
+	CRCShift lastShift;
+};
+
+/**
+ * Default number of bytes hashed by a single task, large enough that scheduling and joining a chunk costs
+ * well under a percent of hashing it.
+ */
+static constexpr uint64_t defaultCRCChunkSize = 1024 * 1024;
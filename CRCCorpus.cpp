@@ -0,0 +1,78 @@
+#include "CRCCorpus.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MessageCorpus::MessageCorpus(const std::string &path, size_t messageSize) : messageSize(messageSize) {
+	try {
+		if (std::filesystem::is_directory(path)) {
+			std::vector<std::string> paths;
+			for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(path)) {
+				if (entry.is_regular_file()) {
+					paths.push_back(entry.path().string());
+				}
+			}
+			std::sort(paths.begin(), paths.end());
+			for (const std::string &filePath : paths) {
+				mapFile(filePath);
+			}
+		} else {
+			mapFile(path);
+		}
+	} catch (...) {
+		unmapFiles();
+		throw;
+	}
+
+	if (nrMessages == 0) {
+		unmapFiles();
+		throw std::runtime_error("Corpus " + path + " holds no message of " + std::to_string(messageSize) + " bytes");
+	}
+}
+
+MessageCorpus::~MessageCorpus() { unmapFiles(); }
+
+void MessageCorpus::unmapFiles() noexcept {
+	for (const MappedFile &file : files) {
+		munmap(const_cast<uint8_t *>(file.data), file.size);
+	}
+	files.clear();
+}
+
+void MessageCorpus::mapFile(const std::string &path) {
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Failed to open the corpus " + path + ": " + strerror(errno));
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0) {
+		const int error = errno;
+		close(fd);
+		throw std::runtime_error("Failed to open the corpus " + path + ": " + strerror(error));
+	}
+
+	/*	Files without a whole message are skipped.	*/
+	const size_t size = static_cast<size_t>(status.st_size);
+	if (size < messageSize) {
+		close(fd);
+		return;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	const int error = errno;
+	close(fd);
+	if (data == MAP_FAILED) {
+		throw std::runtime_error("Failed to map the corpus " + path + ": " + strerror(error));
+	}
+	/*	Every task reads a contiguous range of messages, read ahead of it.	*/
+	madvise(data, size, MADV_SEQUENTIAL);
+
+	files.push_back({static_cast<const uint8_t *>(data), size, nrMessages});
+	nrMessages += size / messageSize;
+}
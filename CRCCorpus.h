@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Real payloads as the sampled messages, a file or every regular file of a directory mapped read-only and
+ * sliced into messages of a fixed size, the tail of a file shorter than a message is skipped. The messages are
+ * read from the mapping in place, the pages are only loaded as they are sampled, so that files larger than the
+ * memory can be sampled at the bandwidth of the storage.
+ */
+class MessageCorpus {
+  public:
+	/**
+	 * Map the file, or the files of the directory in the order of their names. Throws std::runtime_error if a
+	 * file can not be mapped or there is no message.
+	 */
+	MessageCorpus(const std::string &path, size_t messageSize);
+	~MessageCorpus();
+
+	MessageCorpus(const MessageCorpus &) = delete;
+	MessageCorpus &operator=(const MessageCorpus &) = delete;
+
+	uint64_t getNrMessages() const noexcept { return nrMessages; }
+
+	size_t getMessageSize() const noexcept { return messageSize; }
+
+	/**
+	 * The message at the index, which is less than the number of messages.
+	 */
+	const void *getMessage(uint64_t index) const noexcept {
+		size_t file = 0;
+		if (files.size() > 1) {
+			/*	Last file starting at or before the message.	*/
+			size_t first = 0, last = files.size();
+			while (last - first > 1) {
+				const size_t middle = (first + last) / 2;
+				if (files[middle].firstMessage <= index) {
+					first = middle;
+				} else {
+					last = middle;
+				}
+			}
+			file = first;
+		}
+		return files[file].data + (index - files[file].firstMessage) * messageSize;
+	}
+
+  private:
+	struct MappedFile {
+		const uint8_t *data;
+		size_t size;
+		uint64_t firstMessage; /*	Index of the first message of the file within the corpus.	*/
+	};
+
+	void mapFile(const std::string &path);
+	void unmapFiles() noexcept;
+
+	const size_t messageSize;
+	std::vector<MappedFile> files;
+	uint64_t nrMessages = 0;
+};
@@ -0,0 +1,52 @@
+#include "CRCCorrection.h"
+#include <cassert>
+
+SyndromeCorrectionTable::SyndromeCorrectionTable(const std::vector<uint64_t> &syndromes, unsigned int maxBits) {
+	const uint64_t nrBits = syndromes.size();
+	assert(maxBits >= 1 && maxBits <= correctionMaxBits);
+	assert(maxBits < 2 || nrBits <= correctionMaxPairMessageBits);
+
+	/*	At most half full, for short probe sequences.	*/
+	const uint64_t nrErrors = maxBits >= 2 ? nrBits + nrBits * (nrBits - 1) / 2 : nrBits;
+	unsigned int nrSlotBits = 4;
+	while ((static_cast<uint64_t>(1) << nrSlotBits) < 2 * nrErrors) {
+		nrSlotBits++;
+	}
+	entries.assign(static_cast<size_t>(1) << nrSlotBits, Entry{0, {noPosition, noPosition}});
+	slotMask = entries.size() - 1;
+	slotShift = 64 - nrSlotBits;
+
+	for (uint32_t i = 0; i < nrBits; i++) {
+		insert(syndromes[i], i, noPosition);
+	}
+	if (maxBits >= 2) {
+		for (uint32_t i = 0; i < nrBits; i++) {
+			for (uint32_t j = i + 1; j < nrBits; j++) {
+				insert(syndromes[i] ^ syndromes[j], i, j);
+			}
+		}
+	}
+}
+
+void SyndromeCorrectionTable::insert(uint64_t syndrome, uint32_t first, uint32_t second) {
+	/*	Errors with a zero syndrome go undetected, there is nothing to correct.	*/
+	if (syndrome == 0) {
+		return;
+	}
+
+	/*	The errors are inserted from the fewest bits, the error of fewer bits is the more likely one and keeps
+	 *	the syndrome. Only errors of as many bits make it ambiguous, which keeps the number of bits in the
+	 *	second position.	*/
+	size_t slot = getSlot(syndrome);
+	while (entries[slot].syndrome != 0) {
+		if (entries[slot].syndrome == syndrome) {
+			const bool isSingle = entries[slot].positions[1] == noPosition;
+			if (isSingle == (second == noPosition)) {
+				entries[slot].positions[0] = ambiguousPosition;
+			}
+			return;
+		}
+		slot = (slot + 1) & slotMask;
+	}
+	entries[slot] = Entry{syndrome, {first, second}};
+}
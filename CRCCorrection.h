@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*	Largest number of corrected bits, and the largest message in bits for correcting two, whose table holds
+ *	a syndrome per pair of bits.	*/
+static constexpr unsigned int correctionMaxBits = 2;
+static constexpr uint32_t correctionMaxPairMessageBits = 2048;
+
+/**
+ * Open addressing table from a syndrome to the error of up to maxBits bits causing it, for correcting the
+ * error from the CRC difference of a received message. A syndrome is corrected to the error of the fewest
+ * bits causing it, the most likely one while bits flip with a probability below a half, and is ambiguous and
+ * not corrected when several errors of that many bits share it. Each entry holds its key and bit positions
+ * within 16 bytes, so a lookup mostly touches a single cache line.
+ */
+class SyndromeCorrectionTable {
+  public:
+	SyndromeCorrectionTable(const std::vector<uint64_t> &syndromes, unsigned int maxBits);
+
+	/**
+	 * Bit positions of the error with the syndrome, ascending. Returns the number of bits, or 0 if the
+	 * syndrome can not be corrected.
+	 */
+	unsigned int find(uint64_t syndrome, uint32_t positions[correctionMaxBits]) const noexcept {
+		for (size_t slot = getSlot(syndrome); entries[slot].syndrome != 0; slot = (slot + 1) & slotMask) {
+			const Entry &entry = entries[slot];
+			if (entry.syndrome == syndrome) {
+				if (entry.positions[0] == ambiguousPosition) {
+					return 0;
+				}
+				positions[0] = entry.positions[0];
+				positions[1] = entry.positions[1];
+				return entry.positions[1] == noPosition ? 1 : 2;
+			}
+		}
+		return 0;
+	}
+
+  private:
+	static constexpr uint32_t noPosition = UINT32_MAX;
+	static constexpr uint32_t ambiguousPosition = UINT32_MAX - 1;
+
+	struct Entry {
+		uint64_t syndrome; /*	0 for an empty slot, a zero syndrome is never detected.	*/
+		uint32_t positions[correctionMaxBits];
+	};
+
+	size_t getSlot(uint64_t syndrome) const noexcept {
+		return static_cast<size_t>((syndrome * 0x9E3779B97F4A7C15ull) >> slotShift);
+	}
+
+	void insert(uint64_t syndrome, uint32_t first, uint32_t second);
+
+	std::vector<Entry> entries;
+	size_t slotMask = 0;
+	unsigned int slotShift = 64;
+};
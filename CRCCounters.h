@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Counters of a single worker thread, padded to its own cache line so that the workers never
+ * write to a shared line.
+ */
+struct alignas(64) CounterShard {
+	std::atomic_uint64_t nrSamples{0};
+	std::atomic_uint64_t nrCollisions{0};
+	std::atomic_uint64_t busyNanoSeconds{0};
+};
+
+/**
+ * Sample and collision counters sharded per worker thread. Every thread adds to the shard it
+ * was assigned on first use, the totals are only aggregated when read by the reporter.
+ */
+class ShardedCounters {
+  public:
+	explicit ShardedCounters(unsigned int nrShards) : nrShards(nrShards), shards(new CounterShard[nrShards]) {}
+
+	unsigned int getNrShards() const noexcept { return nrShards; }
+
+	const CounterShard &getShard(unsigned int index) const noexcept { return shards[index]; }
+
+	void add(uint64_t nrSamples, uint64_t nrCollisions, uint64_t busyNanoSeconds) noexcept {
+		CounterShard &shard = shards[getThreadIndex() % nrShards];
+		shard.nrSamples.fetch_add(nrSamples, std::memory_order_relaxed);
+		shard.nrCollisions.fetch_add(nrCollisions, std::memory_order_relaxed);
+		shard.busyNanoSeconds.fetch_add(busyNanoSeconds, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Count the samples and collisions of a previous process, continued from its checkpoint. They are part of
+	 * the totals but of no shard.
+	 */
+	void restore(uint64_t nrSamples, uint64_t nrCollisions) noexcept {
+		nrRestoredSamples = nrSamples;
+		nrRestoredCollisions = nrCollisions;
+	}
+
+	uint64_t getTotalSamples() const noexcept {
+		uint64_t total = nrRestoredSamples;
+		for (unsigned int i = 0; i < nrShards; i++) {
+			total += shards[i].nrSamples.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	uint64_t getTotalCollisions() const noexcept {
+		uint64_t total = nrRestoredCollisions;
+		for (unsigned int i = 0; i < nrShards; i++) {
+			total += shards[i].nrCollisions.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+  private:
+	/*	Threads are numbered in order of their first use of any counters.	*/
+	static unsigned int getThreadIndex() noexcept {
+		static std::atomic_uint nextThreadIndex{0};
+		thread_local const unsigned int threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+		return threadIndex;
+	}
+
+	const unsigned int nrShards;
+	std::unique_ptr<CounterShard[]> shards;
+	uint64_t nrRestoredSamples = 0;
+	uint64_t nrRestoredCollisions = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include "CRCSyndrome.h"
+#include "RandGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * How the bit errors of a message are drawn.
+ */
+enum class ErrorModel {
+	Trials,	  /*	nrBitError flips at random positions, each with the error probability, positions may repeat.	*/
+	Distinct, /*	As Trials, but every flip hits another position.	*/
+	Channel,  /*	Every bit flips independently with the bit error rate.	*/
+	Burst,	  /*	A burst of the burst length at a random position, in the transmitted bit order.	*/
+};
+
+/**
+ * Draw the bit indices to flip, each of the nrBitError flips happens with the given probability.
+ * Returns the number of bit indices written.
+ */
+static inline unsigned int generateBitErrorIndices(uint32_t dataBitSize, PCGRandom &gen, const unsigned int nrBitError,
+												   const float probability, uint32_t *bitIndices) noexcept {
+	unsigned int nrFlipped = 0;
+
+	/*	Compare against an integer threshold, no draw at all when every flip happens.	*/
+	const bool alwaysFlip = probability >= 1.0f;
+	const uint64_t threshold = static_cast<uint64_t>(static_cast<double>(probability) * 4294967296.0);
+
+	for (unsigned int i = 0; i < nrBitError; i++) {
+		if (alwaysFlip || gen.getRandom() < threshold) {
+			bitIndices[nrFlipped++] = gen.getRandomRange(dataBitSize);
+		}
+	}
+	return nrFlipped;
+}
+
+/**
+ * Draw the bit indices to flip like generateBitErrorIndices, but redraw every index already flipped, by this
+ * call or within the nrPrevious indices before bitIndices. Every prefix of the indices is thereby a uniform
+ * set of distinct positions. The number of flips must not exceed dataBitSize.
+ * Returns the number of bit indices written.
+ */
+static inline unsigned int generateDistinctBitErrorIndices(uint32_t dataBitSize, PCGRandom &gen,
+														   const unsigned int nrBitError, const float probability,
+														   uint32_t *bitIndices, unsigned int nrPrevious = 0) noexcept {
+	uint32_t *const first = bitIndices - nrPrevious;
+	unsigned int nrFlipped = 0;
+
+	const bool alwaysFlip = probability >= 1.0f;
+	const uint64_t threshold = static_cast<uint64_t>(static_cast<double>(probability) * 4294967296.0);
+
+	for (unsigned int i = 0; i < nrBitError; i++) {
+		if (alwaysFlip || gen.getRandom() < threshold) {
+			/*	Rejection is cheap while the flips are few compared to the message bits.	*/
+			uint32_t bitIndex;
+			do {
+				bitIndex = gen.getRandomRange(dataBitSize);
+			} while (std::find(first, bitIndices + nrFlipped, bitIndex) != bitIndices + nrFlipped);
+			bitIndices[nrFlipped++] = bitIndex;
+		}
+	}
+	return nrFlipped;
+}
+
+/**
+ * Draw the bits flipped by a channel with a bit error rate, appended to bitIndices in ascending order.
+ * The gaps between the flipped bits are geometric, floor(log(U) / log(1 - ber)), so the cost follows the
+ * number of errors rather than the message size. logNoError is log(1 - ber).
+ * Returns the number of bit indices appended.
+ */
+static inline unsigned int generateChannelBitErrorIndices(uint32_t dataBitSize, PCGRandom &gen, double logNoError,
+														  std::vector<uint32_t> &bitIndices) {
+	const size_t nrPrevious = bitIndices.size();
+	uint64_t position = 0;
+	while (true) {
+		const double gap = std::floor(std::log(gen.getRandomOpenUnit()) / logNoError);
+		if (gap >= static_cast<double>(dataBitSize - position)) {
+			break;
+		}
+		position += static_cast<uint64_t>(gap);
+		bitIndices.push_back(static_cast<uint32_t>(position));
+		position++;
+	}
+	return static_cast<unsigned int>(bitIndices.size() - nrPrevious);
+}
+
+/**
+ * Draw a burst of exactly burstLength bits at a random position, appended to bitIndices. The first and last bit
+ * of the burst are flipped, each bit in between with probability 1/2. The indices are transmitted positions,
+ * for syndromes ordered as BurstSyndromes::getColumns.
+ * Returns the number of bit indices appended.
+ */
+static inline unsigned int generateBurstBitErrorIndices(uint32_t dataBitSize, PCGRandom &gen, unsigned int burstLength,
+														std::vector<uint32_t> &bitIndices) {
+	const size_t nrPrevious = bitIndices.size();
+	const uint32_t first = gen.getRandomRange(dataBitSize - burstLength + 1);
+
+	bitIndices.push_back(first);
+	uint32_t bits = 0;
+	for (unsigned int k = 1; k + 1 < burstLength; k++) {
+		if ((k - 1) % 32 == 0) {
+			bits = gen.getRandom();
+		}
+		if (bits & 1) {
+			bitIndices.push_back(first + k);
+		}
+		bits >>= 1;
+	}
+	if (burstLength > 1) {
+		bitIndices.push_back(first + burstLength - 1);
+	}
+	return static_cast<unsigned int>(bitIndices.size() - nrPrevious);
+}
+
+/**
+ * Check if the drawn flips leave the message unchanged. Only the trials model can flip a bit back, the
+ * bit indices are sorted in place for it.
+ */
+static inline bool isErrorEmpty(ErrorModel model, uint32_t *bitIndices, unsigned int nrFlipped) noexcept {
+	return model == ErrorModel::Trials ? isErrorPatternEmpty(bitIndices, nrFlipped) : nrFlipped == 0;
+}
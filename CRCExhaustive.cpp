@@ -0,0 +1,175 @@
+#include "CRCExhaustive.h"
+#include "marl/defer.h"
+#include "marl/scheduler.h"
+#include "marl/waitgroup.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <unordered_map>
+
+/*	Upper bound of the memory used for holding weight-2 syndromes at once.	*/
+static constexpr uint64_t exhaustivePairMemoryBudget = 1ull << 30;
+
+static inline uint32_t pairPartition(uint64_t syndrome, uint32_t nrPartitions) noexcept {
+	return static_cast<uint32_t>(((syndrome * 0x9E3779B97F4A7C15ull) >> 32) % nrPartitions);
+}
+
+static uint64_t binomial(uint64_t n, unsigned int k) noexcept {
+	if (k > n) {
+		return 0;
+	}
+	uint64_t result = 1;
+	for (unsigned int i = 1; i <= k; i++) {
+		result = result * (n - k + i) / i;
+	}
+	return result;
+}
+
+std::vector<ExhaustiveWeightResult> computeExhaustiveUndetected(const std::vector<uint64_t> &syndromes,
+																unsigned int maxWeight) {
+	const uint64_t nrBits = syndromes.size();
+	assert(nrBits <= exhaustiveMaxMessageBits);
+	assert(maxWeight >= 1 && maxWeight <= exhaustiveMaxWeight);
+
+	/*	Multiplicity of each weight-1 syndrome.	*/
+	std::unordered_map<uint64_t, uint32_t> singleCount;
+	for (const uint64_t syndrome : syndromes) {
+		singleCount[syndrome]++;
+	}
+
+	/*	Weight 1: the syndrome itself is zero.	*/
+	const auto zeroIt = singleCount.find(0);
+	const uint64_t nrZero = zeroIt != singleCount.end() ? zeroIt->second : 0;
+
+	/*	Weight 2: two bits with equal syndromes.	*/
+	uint64_t nrEqualPairs = 0;
+	for (const auto &entry : singleCount) {
+		nrEqualPairs += binomial(entry.second, 2);
+	}
+
+	/*	Weight 3 and 4: match the weight-2 syndromes against the weight-1 and weight-2 syndromes.
+	 *	Every task generates the pairs of its own range of first bits and scatters them into hash
+	 *	partitions, each partition is then sorted and counted by its own task. The partitions are
+	 *	spread over rounds when all the pairs do not fit in memory at once, every round generates
+	 *	the pairs again and keeps those of its partitions.	*/
+	std::atomic_uint64_t pairsWithSingle{0};
+	std::atomic_uint64_t pairsWithPair{0};
+	if (maxWeight >= 3) {
+		const uint64_t nrPairs = nrBits * (nrBits - 1) / 2;
+		const uint32_t nrWorkers = std::max<uint32_t>(1, marl::Scheduler::get()->config().workerThread.count);
+		const uint32_t nrRounds = static_cast<uint32_t>(std::max<uint64_t>(
+			1, (nrPairs * sizeof(uint64_t) + exhaustivePairMemoryBudget - 1) / exhaustivePairMemoryBudget));
+		const uint32_t nrPartitions = nrWorkers * nrRounds;
+
+		/*	First bit of the pairs of every task, the bit i pairing with the nrBits - 1 - i bits after it,
+		 *	so that the tasks generate about as many pairs.	*/
+		std::vector<uint64_t> firstBits(nrWorkers + 1, nrBits);
+		firstBits[0] = 0;
+		uint64_t nrTaskPairs = 0;
+		for (uint64_t i = 0, task = 1; i < nrBits && task < nrWorkers; i++) {
+			nrTaskPairs += nrBits - 1 - i;
+			while (task < nrWorkers && nrTaskPairs >= nrPairs * task / nrWorkers) {
+				firstBits[task++] = i + 1;
+			}
+		}
+
+		/*	Pair syndromes of every task into every partition of the round.	*/
+		std::vector<std::vector<uint64_t>> buckets(static_cast<size_t>(nrWorkers) * nrWorkers);
+
+		for (uint32_t round = 0; round < nrRounds; round++) {
+			const uint32_t firstPartition = round * nrWorkers;
+			marl::WaitGroup pairsDone(nrWorkers);
+
+			for (uint32_t task = 0; task < nrWorkers; task++) {
+				marl::schedule([&, task, firstPartition] {
+					defer(pairsDone.done());
+
+					std::vector<uint64_t> *taskBuckets = &buckets[static_cast<size_t>(task) * nrWorkers];
+					for (uint64_t i = firstBits[task]; i < firstBits[task + 1]; i++) {
+						const uint64_t syndrome = syndromes[i];
+						for (uint64_t j = i + 1; j < nrBits; j++) {
+							const uint64_t pairSyndrome = syndrome ^ syndromes[j];
+							const uint32_t partition = pairPartition(pairSyndrome, nrPartitions);
+							if (partition >= firstPartition && partition < firstPartition + nrWorkers) {
+								taskBuckets[partition - firstPartition].push_back(pairSyndrome);
+							}
+						}
+					}
+				});
+			}
+			pairsDone.wait();
+
+			marl::WaitGroup partitionsDone(nrWorkers);
+			for (uint32_t partition = 0; partition < nrWorkers; partition++) {
+				marl::schedule([&, partition] {
+					defer(partitionsDone.done());
+
+					/*	Gather the buckets of the partition, releasing each one once copied.	*/
+					size_t nrPartitionPairs = 0;
+					for (uint32_t task = 0; task < nrWorkers; task++) {
+						nrPartitionPairs += buckets[static_cast<size_t>(task) * nrWorkers + partition].size();
+					}
+					std::vector<uint64_t> pairSyndromes;
+					pairSyndromes.reserve(nrPartitionPairs);
+					for (uint32_t task = 0; task < nrWorkers; task++) {
+						std::vector<uint64_t> &bucket = buckets[static_cast<size_t>(task) * nrWorkers + partition];
+						pairSyndromes.insert(pairSyndromes.end(), bucket.begin(), bucket.end());
+						std::vector<uint64_t>().swap(bucket);
+					}
+
+					std::sort(pairSyndromes.begin(), pairSyndromes.end());
+
+					uint64_t localWithSingle = 0, localWithPair = 0;
+					for (size_t begin = 0; begin < pairSyndromes.size();) {
+						size_t end = begin + 1;
+						while (end < pairSyndromes.size() && pairSyndromes[end] == pairSyndromes[begin]) {
+							end++;
+						}
+						const uint64_t multiplicity = end - begin;
+						localWithPair += multiplicity * (multiplicity - 1) / 2;
+
+						const auto single = singleCount.find(pairSyndromes[begin]);
+						if (single != singleCount.end()) {
+							localWithSingle += multiplicity * single->second;
+						}
+						begin = end;
+					}
+
+					pairsWithSingle.fetch_add(localWithSingle);
+					pairsWithPair.fetch_add(localWithPair);
+				});
+			}
+			partitionsDone.wait();
+		}
+	}
+
+	std::vector<ExhaustiveWeightResult> results;
+	for (unsigned int weight = 1; weight <= maxWeight; weight++) {
+		ExhaustiveWeightResult result = {weight, binomial(nrBits, weight), 0};
+
+		switch (weight) {
+		case 1:
+			result.nrUndetected = nrZero;
+			break;
+		case 2:
+			result.nrUndetected = nrEqualPairs;
+			break;
+		case 3:
+			/*	Every undetected triple is matched once per bit as the single. Remove the matches where
+			 *	the single is one of the pair's own bits, which requires the other bit to have a zero
+			 *	syndrome.	*/
+			result.nrUndetected = (pairsWithSingle.load() - nrZero * (nrBits - 1)) / 3;
+			break;
+		case 4:
+			/*	Every undetected quadruple is matched once per split into two pairs. Remove the matches
+			 *	where the pairs share a bit, which requires the remaining two bits to be equal.	*/
+			result.nrUndetected = (pairsWithPair.load() - nrEqualPairs * (nrBits - 2)) / 3;
+			break;
+		default:
+			assert(0);
+		}
+		results.push_back(result);
+	}
+
+	return results;
+}
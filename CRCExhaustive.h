@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * Exact number of undetected error patterns of a single Hamming weight.
+ */
+struct ExhaustiveWeightResult {
+	unsigned int weight;
+	uint64_t nrPatterns;
+	uint64_t nrUndetected;
+};
+
+/**
+ * Largest supported message, in bits, for the exhaustive enumeration. Keeps the number of
+ * weight-4 patterns within 64-bit counters.
+ */
+static constexpr uint32_t exhaustiveMaxMessageBits = 65536;
+static constexpr unsigned int exhaustiveMaxWeight = 4;
+
+/**
+ * Enumerate every error pattern of weight 1 to maxWeight over the message described by the
+ * per-bit syndrome table and count those whose syndrome is zero, i.e. not detected.
+ * Weight 3 and 4 are counted with a meet-in-the-middle over the weight-2 syndromes, distributed
+ * over the marl scheduler bound to the calling thread.
+ */
+extern std::vector<ExhaustiveWeightResult> computeExhaustiveUndetected(const std::vector<uint64_t> &syndromes,
+																	   unsigned int maxWeight);
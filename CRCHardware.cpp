@@ -0,0 +1,214 @@
+#include "CRCHardware.h"
+#include "CRCCombine.h"
+#include "CRCKernel.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRC_HARDWARE_X86
+#include <immintrin.h>
+#endif
+
+const CPUFeatures &getCPUFeatures() noexcept {
+	static const CPUFeatures features = [] {
+		CPUFeatures detected = {false, false, false};
+#if defined(CRC_HARDWARE_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		detected.sse42 = __builtin_cpu_supports("sse4.2");
+		detected.pclmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+		detected.avx2 = __builtin_cpu_supports("avx2");
+#endif
+		return detected;
+	}();
+	return features;
+}
+
+/**
+ * x^k mod P, with P given without its leading x^width term.
+ */
+static uint64_t xPowModP(unsigned int k, uint64_t polynomial, unsigned int width) noexcept {
+	const uint64_t topBit = static_cast<uint64_t>(1) << (width - 1);
+	const uint64_t mask = width >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << width) - 1;
+
+	uint64_t remainder = 1;
+	for (unsigned int i = 0; i < k; i++) {
+		const bool carry = (remainder & topBit) != 0;
+		remainder = (remainder << 1) & mask;
+		if (carry) {
+			remainder ^= polynomial;
+		}
+	}
+	return remainder;
+}
+
+CRCFoldConstants createCRCFoldConstants(uint64_t polynomial, unsigned int width, bool reflected) noexcept {
+	CRCFoldConstants constants;
+	constants.reflected = reflected;
+
+	if (reflected) {
+		/*	The low lane holds the high degree half. The reflected product is one bit short,
+		 *	compensated by using x^(k - 1).	*/
+		constants.fold16[0] = reflectBits<uint64_t>(xPowModP(128 + 64 - 1, polynomial, width), 64);
+		constants.fold16[1] = reflectBits<uint64_t>(xPowModP(128 - 1, polynomial, width), 64);
+		constants.fold64[0] = reflectBits<uint64_t>(xPowModP(512 + 64 - 1, polynomial, width), 64);
+		constants.fold64[1] = reflectBits<uint64_t>(xPowModP(512 - 1, polynomial, width), 64);
+	} else {
+		constants.fold16[0] = xPowModP(128, polynomial, width);
+		constants.fold16[1] = xPowModP(128 + 64, polynomial, width);
+		constants.fold64[0] = xPowModP(512, polynomial, width);
+		constants.fold64[1] = xPowModP(512 + 64, polynomial, width);
+	}
+	return constants;
+}
+
+#if defined(CRC_HARDWARE_X86)
+
+#define CRC_TARGET_PCLMUL __attribute__((target("pclmul,ssse3")))
+#define CRC_TARGET_SSE42 __attribute__((target("sse4.2")))
+
+CRC_TARGET_PCLMUL static inline __m128i loadBlock(const uint8_t *p, const __m128i &byteOrder, bool reflected) {
+	const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+	return reflected ? block : _mm_shuffle_epi8(block, byteOrder);
+}
+
+CRC_TARGET_PCLMUL static inline __m128i foldBlock(const __m128i &block, const __m128i &constant) {
+	return _mm_xor_si128(_mm_clmulepi64_si128(block, constant, 0x00), _mm_clmulepi64_si128(block, constant, 0x11));
+}
+
+CRC_TARGET_PCLMUL size_t foldCRCPCLMUL(const void *data, size_t size, uint64_t initialXOR,
+									   const CRCFoldConstants &constants, uint8_t *remainder) noexcept {
+	const uint8_t *p = static_cast<const uint8_t *>(data);
+	const bool reflected = constants.reflected;
+
+	/*	Non-reflected CRCs treat the first byte as the highest degree, reverse the byte order.	*/
+	const __m128i byteOrder = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i fold16 = _mm_set_epi64x(static_cast<long long>(constants.fold16[1]),
+										  static_cast<long long>(constants.fold16[0]));
+	const __m128i fold64 = _mm_set_epi64x(static_cast<long long>(constants.fold64[1]),
+										  static_cast<long long>(constants.fold64[0]));
+
+	/*	The initial register value is equivalent to XORing it into the beginning of the message.	*/
+	__m128i first = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+								  _mm_set_epi64x(0, static_cast<long long>(initialXOR)));
+	__m128i acc0 = reflected ? first : _mm_shuffle_epi8(first, byteOrder);
+	__m128i acc1 = loadBlock(p + 16, byteOrder, reflected);
+	__m128i acc2 = loadBlock(p + 32, byteOrder, reflected);
+	__m128i acc3 = loadBlock(p + 48, byteOrder, reflected);
+	size_t offset = 64;
+
+	/*	Four independent accumulators to hide the multiplication latency.	*/
+	for (; offset + 64 <= size; offset += 64) {
+		acc0 = _mm_xor_si128(foldBlock(acc0, fold64), loadBlock(p + offset, byteOrder, reflected));
+		acc1 = _mm_xor_si128(foldBlock(acc1, fold64), loadBlock(p + offset + 16, byteOrder, reflected));
+		acc2 = _mm_xor_si128(foldBlock(acc2, fold64), loadBlock(p + offset + 32, byteOrder, reflected));
+		acc3 = _mm_xor_si128(foldBlock(acc3, fold64), loadBlock(p + offset + 48, byteOrder, reflected));
+	}
+
+	__m128i acc = _mm_xor_si128(foldBlock(acc0, fold16), acc1);
+	acc = _mm_xor_si128(foldBlock(acc, fold16), acc2);
+	acc = _mm_xor_si128(foldBlock(acc, fold16), acc3);
+
+	for (; offset + 16 <= size; offset += 16) {
+		acc = _mm_xor_si128(foldBlock(acc, fold16), loadBlock(p + offset, byteOrder, reflected));
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), reflected ? acc : _mm_shuffle_epi8(acc, byteOrder));
+	return offset;
+}
+
+/**
+ * Reflected CRC-32C register of the crc32 instruction as a kernel, without an initial value or final XOR, for
+ * the shift of the register by zero bytes.
+ */
+struct CRC32CRegisterKernel {
+	using Register = uint32_t;
+
+	static constexpr uint32_t residue(uint32_t crc) noexcept { return crc; }
+
+	static uint32_t update(uint32_t crc, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; i++) {
+			crc ^= p[i];
+			for (unsigned int bit = 0; bit < 8; bit++) {
+				crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+			}
+		}
+		return crc;
+	}
+};
+
+/**
+ * Shift of the CRC-32C register by the bytes of a stream, tabulated per byte of the register.
+ */
+struct CRC32CStreamShift {
+	uint32_t table[4][256];
+
+	uint32_t apply(uint32_t crc) const noexcept {
+		return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^
+			   table[3][crc >> 24];
+	}
+};
+
+static const CRC32CStreamShift &getCRC32CStreamShift() noexcept {
+	static const CRC32CStreamShift streamShift = [] {
+		const CRCShift shift(CRCShift::createByteShift<CRC32CRegisterKernel>(), crc32cStreamSize);
+		CRC32CStreamShift tabulated;
+		for (unsigned int k = 0; k < 4; k++) {
+			for (unsigned int value = 0; value < 256; value++) {
+				tabulated.table[k][value] = static_cast<uint32_t>(shift.apply(static_cast<uint64_t>(value) << (k * 8)));
+			}
+		}
+		return tabulated;
+	}();
+	return streamShift;
+}
+
+CRC_TARGET_SSE42 uint32_t updateCRC32CSSE42(uint32_t crc, const void *data, size_t size) noexcept {
+	const uint8_t *p = static_cast<const uint8_t *>(data);
+
+#if defined(__x86_64__)
+	/*	Three consecutive streams at a time, the first continuing the register and the others from zero, joined
+	 *	with crc32(r, A || B) = shift_|B|(crc32(r, A)) ^ crc32(0, B).	*/
+	if (size >= 3 * crc32cStreamSize) {
+		const CRC32CStreamShift &streamShift = getCRC32CStreamShift();
+		for (; size >= 3 * crc32cStreamSize; size -= 3 * crc32cStreamSize, p += 3 * crc32cStreamSize) {
+			uint64_t crc0 = crc, crc1 = 0, crc2 = 0;
+			for (size_t i = 0; i < crc32cStreamSize; i += 8) {
+				uint64_t word0, word1, word2;
+				std::memcpy(&word0, p + i, sizeof(word0));
+				std::memcpy(&word1, p + crc32cStreamSize + i, sizeof(word1));
+				std::memcpy(&word2, p + 2 * crc32cStreamSize + i, sizeof(word2));
+				crc0 = _mm_crc32_u64(crc0, word0);
+				crc1 = _mm_crc32_u64(crc1, word1);
+				crc2 = _mm_crc32_u64(crc2, word2);
+			}
+			crc = streamShift.apply(streamShift.apply(static_cast<uint32_t>(crc0)) ^ static_cast<uint32_t>(crc1)) ^
+				  static_cast<uint32_t>(crc2);
+		}
+	}
+
+	uint64_t crc64 = crc;
+	for (; size >= 8; size -= 8, p += 8) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+	}
+	crc = static_cast<uint32_t>(crc64);
+#endif
+	for (; size >= 4; size -= 4, p += 4) {
+		uint32_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+	}
+	for (; size > 0; size--, p++) {
+		crc = _mm_crc32_u8(crc, *p);
+	}
+	return crc;
+}
+
+#else
+
+size_t foldCRCPCLMUL(const void *, size_t, uint64_t, const CRCFoldConstants &, uint8_t *) noexcept { return 0; }
+
+uint32_t updateCRC32CSSE42(uint32_t crc, const void *, size_t) noexcept { return crc; }
+
+#endif
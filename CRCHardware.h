@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Instruction set extensions used by the CRC kernels, detected once at startup.
+ */
+struct CPUFeatures {
+	bool sse42;
+	bool pclmul;
+	bool avx2;
+};
+
+extern const CPUFeatures &getCPUFeatures() noexcept;
+
+/**
+ * Constants for folding 128-bit blocks with carry-less multiplication, x^k mod P for the
+ * 16 and 64 byte fold distances. Arranged so that the low and high 64-bit lanes of a block
+ * are multiplied by the low and high constant respectively.
+ */
+struct CRCFoldConstants {
+	uint64_t fold16[2];
+	uint64_t fold64[2];
+	bool reflected;
+};
+
+extern CRCFoldConstants createCRCFoldConstants(uint64_t polynomial, unsigned int width, bool reflected) noexcept;
+
+/**
+ * Minimum message size for the carry-less multiplication folding.
+ */
+static constexpr size_t pclmulMinSize = 64;
+
+/**
+ * Fold the message into a 16 byte remainder congruent to it modulo P, using PCLMULQDQ.
+ * initialXOR is XORed into the first 8 bytes, in message byte order. Returns the number of bytes
+ * consumed, the remaining bytes must be processed after the remainder starting from a zero register.
+ * Requires size >= pclmulMinSize and CPUFeatures::pclmul.
+ */
+extern size_t foldCRCPCLMUL(const void *data, size_t size, uint64_t initialXOR, const CRCFoldConstants &constants,
+							uint8_t *remainder) noexcept;
+
+/**
+ * Bytes of each of the three streams hashed at once by the SSE4.2 CRC-32C kernel. The crc32 instruction has a
+ * latency of three cycles and a throughput of one per cycle, so three independent streams keep it busy.
+ */
+static constexpr size_t crc32cStreamSize = 256;
+
+/**
+ * CRC-32C update using the SSE4.2 crc32 instruction, on the reflected register. Messages of at least three
+ * streams are hashed as three interleaved streams joined by a shift of the register.
+ * Requires CPUFeatures::sse42.
+ */
+extern uint32_t updateCRC32CSSE42(uint32_t crc, const void *data, size_t size) noexcept;
@@ -0,0 +1,190 @@
+#include "CRCImportance.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void ImportanceSampleTotals::merge(const ImportanceSampleTotals &other) noexcept {
+	nrSamples += other.nrSamples;
+	nrHits += other.nrHits;
+	sumEstimate += other.sumEstimate;
+	sumEstimate2 += other.sumEstimate2;
+	sumWeight += other.sumWeight;
+	sumWeight2 += other.sumWeight2;
+}
+
+double ImportanceSampleTotals::getEstimate() const noexcept {
+	return nrSamples > 0 ? sumEstimate / static_cast<double>(nrSamples) : 0;
+}
+
+double ImportanceSampleTotals::getStandardError() const noexcept {
+	if (nrSamples < 2) {
+		return 0;
+	}
+	const double n = static_cast<double>(nrSamples);
+	const double mean = sumEstimate / n;
+	const double variance = std::max(0.0, (sumEstimate2 - n * mean * mean) / (n - 1));
+	return std::sqrt(variance / n);
+}
+
+double ImportanceSampleTotals::getEffectiveSampleSize() const noexcept {
+	return sumWeight2 > 0 ? sumWeight * sumWeight / sumWeight2 : 0;
+}
+
+/*	Walsh-Hadamard transform in place, over the integers modulo 2^64.	*/
+static void transformWalshHadamard(std::vector<uint64_t> &values) noexcept {
+	for (size_t half = 1; half < values.size(); half *= 2) {
+		for (size_t i = 0; i < values.size(); i += 2 * half) {
+			for (size_t j = i; j < i + half; j++) {
+				const uint64_t sum = values[j] + values[j + half];
+				values[j + half] = values[j] - values[j + half];
+				values[j] = sum;
+			}
+		}
+	}
+}
+
+ImportanceSampler::ImportanceSampler(const std::vector<uint64_t> &syndromes, double mixture)
+	: syndromes(syndromes), mixture(mixture), sortedSyndromes(syndromes) {
+	std::sort(sortedSyndromes.begin(), sortedSyndromes.end());
+
+	/*	Match on a few more bits than needed to tell the bits apart, a random syndrome then lands
+	 *	on a partial match with a probability of about 1 / 256.	*/
+	uint64_t syndromeBits = 0;
+	for (const uint64_t syndrome : syndromes) {
+		syndromeBits |= syndrome;
+	}
+	unsigned int nrPartialBits = 1;
+	while ((static_cast<uint64_t>(1) << nrPartialBits) < syndromes.size()) {
+		nrPartialBits++;
+	}
+	unsigned int width = 0;
+	while (width < 64 && (syndromeBits >> width) != 0) {
+		width++;
+	}
+	nrPartialBits = std::max(1u, std::min({nrPartialBits + 8, 24u, width}));
+	partialMask = (static_cast<uint64_t>(1) << nrPartialBits) - 1;
+
+	partialMatches.assign(((static_cast<uint64_t>(1) << nrPartialBits) + 63) / 64, 0);
+	for (const uint64_t syndrome : syndromes) {
+		const uint64_t low = syndrome & partialMask;
+		partialMatches[low / 64] |= static_cast<uint64_t>(1) << (low % 64);
+	}
+
+	partialBits.resize(syndromes.size());
+	std::iota(partialBits.begin(), partialBits.end(), 0);
+	std::sort(partialBits.begin(), partialBits.end(), [&](uint32_t a, uint32_t b) {
+		return (syndromes[a] & partialMask) < (syndromes[b] & partialMask);
+	});
+	partialSyndromes.resize(syndromes.size());
+	for (size_t i = 0; i < partialBits.size(); i++) {
+		partialSyndromes[i] = syndromes[partialBits[i]] & partialMask;
+	}
+
+	/*	The pairs are the XOR convolution of the number of bits of every low syndrome with itself, the product of
+	 *	their transforms transformed back. Modulo 2^64 the result is exact while it fits in 64 - nrPartialBits
+	 *	bits, once scaled by the size of the transform.	*/
+	nrPartialPairs.assign(static_cast<size_t>(1) << nrPartialBits, 0);
+	for (const uint64_t syndrome : syndromes) {
+		const uint64_t nrBits = ++nrPartialPairs[syndrome & partialMask];
+		maxPartialBits = std::max(maxPartialBits, static_cast<uint32_t>(nrBits));
+	}
+	transformWalshHadamard(nrPartialPairs);
+	for (uint64_t &value : nrPartialPairs) {
+		value *= value;
+	}
+	transformWalshHadamard(nrPartialPairs);
+	for (uint64_t &value : nrPartialPairs) {
+		value >>= nrPartialBits;
+	}
+}
+
+uint32_t ImportanceSampler::countSyndrome(uint64_t syndrome) const noexcept {
+	const auto range = std::equal_range(sortedSyndromes.begin(), sortedSyndromes.end(), syndrome);
+	return static_cast<uint32_t>(range.second - range.first);
+}
+
+uint32_t ImportanceSampler::findPartialSyndrome(uint64_t low, size_t &first) const noexcept {
+	const auto range = std::equal_range(partialSyndromes.begin(), partialSyndromes.end(), low);
+	first = static_cast<size_t>(range.first - partialSyndromes.begin());
+	return static_cast<uint32_t>(range.second - range.first);
+}
+
+void ImportanceSampler::sample(uint32_t nrBitError, uint64_t nrSamples, PCGRandom &gen,
+							   ImportanceSampleTotals &totals) const {
+	const uint32_t nrBits = static_cast<uint32_t>(syndromes.size());
+	const double nominal = 1.0 / nrBits;
+	std::vector<uint32_t> bitIndices(nrBitError);
+
+	for (uint64_t i = 0; i < nrSamples; i++) {
+		uint64_t syndrome = 0;
+		double weight = 1;
+		uint32_t nrDrawn = 0;
+
+		for (; nrDrawn + 2 < nrBitError; nrDrawn++) {
+			bitIndices[nrDrawn] = gen.getRandomRange(nrBits);
+			syndrome ^= syndromes[bitIndices[nrDrawn]];
+		}
+
+		if (nrBitError >= 2) {
+			/*	Pairs of a bit leaving a syndrome partially matching a single bit, and that single bit.	*/
+			const uint64_t low = syndrome & partialMask;
+			const uint64_t nrPairs = nrPartialPairs[low];
+
+			uint32_t bitIndex;
+			if (nrPairs == 0 || gen.getRandomNormalized() >= mixture) {
+				bitIndex = gen.getRandomRange(nrBits);
+			} else {
+				/*	A uniform single bit and a uniform bit partially matching it, accepted in proportion to the
+				 *	number of those bits so that every pair is as likely.	*/
+				for (;;) {
+					const uint64_t singleSyndrome = syndrome ^ syndromes[gen.getRandomRange(nrBits)];
+					if (!isPartialMatch(singleSyndrome)) {
+						continue;
+					}
+					size_t first;
+					const uint32_t nrCandidates = findPartialSyndrome(singleSyndrome & partialMask, first);
+					if (gen.getRandomRange(maxPartialBits) < nrCandidates) {
+						bitIndex = partialBits[first + gen.getRandomRange(nrCandidates)];
+						break;
+					}
+				}
+			}
+			double proposal = nrPairs == 0 ? nominal : (1 - mixture) * nominal;
+			if (nrPairs > 0) {
+				size_t first;
+				const uint32_t nrSingles = findPartialSyndrome((syndrome ^ syndromes[bitIndex]) & partialMask, first);
+				proposal += mixture * static_cast<double>(nrSingles) / static_cast<double>(nrPairs);
+			}
+			weight = nominal / proposal;
+
+			bitIndices[nrDrawn++] = bitIndex;
+			syndrome ^= syndromes[bitIndex];
+		}
+
+		/*	The error after the drawn flips, with the flips of the same bit cancelled.	*/
+		std::sort(bitIndices.begin(), bitIndices.begin() + nrDrawn);
+		uint32_t nrRemaining = 0;
+		for (uint32_t k = 0; k < nrDrawn;) {
+			if (k + 1 < nrDrawn && bitIndices[k] == bitIndices[k + 1]) {
+				k += 2;
+			} else {
+				nrRemaining++;
+				k++;
+			}
+		}
+
+		/*	Probability that the last flip cancels the syndrome, without cancelling the error itself.	*/
+		uint32_t nrMatches = countSyndrome(syndrome);
+		if (nrRemaining == 1) {
+			nrMatches--;
+		}
+		const double estimate = weight * nrMatches * nominal;
+
+		totals.nrSamples++;
+		totals.nrHits += nrMatches > 0;
+		totals.sumEstimate += estimate;
+		totals.sumEstimate2 += estimate * estimate;
+		totals.sumWeight += weight;
+		totals.sumWeight2 += weight * weight;
+	}
+}
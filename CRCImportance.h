@@ -0,0 +1,72 @@
+#pragma once
+#include "RandGenerator.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Running sums of the importance sampling estimator.
+ */
+struct ImportanceSampleTotals {
+	uint64_t nrSamples = 0;
+	uint64_t nrHits = 0; /*	Samples with a non-zero contribution.	*/
+	double sumEstimate = 0;
+	double sumEstimate2 = 0;
+	double sumWeight = 0;
+	double sumWeight2 = 0;
+
+	void merge(const ImportanceSampleTotals &other) noexcept;
+
+	double getEstimate() const noexcept;
+	double getStandardError() const noexcept;
+
+	/**
+	 * Kish effective sample size of the likelihood ratios, (sum w)^2 / sum w^2.
+	 */
+	double getEffectiveSampleSize() const noexcept;
+};
+
+/**
+ * Importance sampling estimator of the probability that nrBitError uniformly random bit flips are not
+ * detected, for CRCs where it is too small to observe with plain sampling.
+ *
+ * The flips are drawn uniformly, except for the last two. The second to last is drawn from a mixture
+ * favouring the bits that bring the running syndrome within a partial match, on its low bits, of the
+ * syndrome of a single bit, and is weighted by its likelihood ratio. Those bits are drawn as a uniform pair
+ * of a bit and the single bit it matches, from the number of such pairs for every low syndrome and the bits
+ * listed by their low syndrome, both computed once. The last flip is not drawn, the exact probability that
+ * it cancels the running syndrome is accumulated instead.
+ */
+class ImportanceSampler {
+  public:
+	/**
+	 * mixture is the probability of drawing from the partially matching bits.
+	 */
+	explicit ImportanceSampler(const std::vector<uint64_t> &syndromes, double mixture = 0.5);
+
+	void sample(uint32_t nrBitError, uint64_t nrSamples, PCGRandom &gen, ImportanceSampleTotals &totals) const;
+
+  private:
+	/*	Number of bits with the given syndrome.	*/
+	uint32_t countSyndrome(uint64_t syndrome) const noexcept;
+
+	/*	Number of bits with the given low syndrome, and the index of the first of them in partialBits.	*/
+	uint32_t findPartialSyndrome(uint64_t low, size_t &first) const noexcept;
+
+	bool isPartialMatch(uint64_t syndrome) const noexcept {
+		const uint64_t low = syndrome & partialMask;
+		return (partialMatches[low / 64] >> (low % 64)) & 1;
+	}
+
+	const std::vector<uint64_t> &syndromes;
+	const double mixture;
+	std::vector<uint64_t> sortedSyndromes;
+	/*	Bitset of the low bits of every single bit syndrome.	*/
+	std::vector<uint64_t> partialMatches;
+	/*	Low bits of every single bit syndrome, sorted, and the bit of each.	*/
+	std::vector<uint64_t> partialSyndromes;
+	std::vector<uint32_t> partialBits;
+	/*	Ordered pairs of bits whose low syndromes add up to each low syndrome.	*/
+	std::vector<uint64_t> nrPartialPairs;
+	uint32_t maxPartialBits = 0; /*	Largest number of bits sharing a low syndrome.	*/
+	uint64_t partialMask;
+};
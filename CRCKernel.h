@@ -0,0 +1,629 @@
+#pragma once
+#include "CRCHardware.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * Available implementations of a kernel. selectCRCImplementation takes the last one the kernel and the CPU
+ * support: SSE4.2 crc32 over three interleaved streams for CRC-32C, PCLMULQDQ folding for the other CRCs.
+ */
+enum class CRCImplementation {
+	Bytewise,
+	Slicing8,
+	Slicing16,
+	PCLMUL,
+	SSE42,
+};
+
+static constexpr CRCImplementation allCRCImplementations[] = {CRCImplementation::Bytewise,
+															  CRCImplementation::Slicing8, CRCImplementation::Slicing16,
+															  CRCImplementation::PCLMUL, CRCImplementation::SSE42};
+
+static inline const char *getCRCImplementationName(CRCImplementation implementation) noexcept {
+	switch (implementation) {
+	case CRCImplementation::Bytewise:
+		return "bytewise";
+	case CRCImplementation::Slicing8:
+		return "slicing-by-8";
+	case CRCImplementation::Slicing16:
+		return "slicing-by-16";
+	case CRCImplementation::PCLMUL:
+		return "pclmul";
+	case CRCImplementation::SSE42:
+		return "sse4.2";
+	default:
+		return "unknown";
+	}
+}
+
+static inline bool parseCRCImplementation(const std::string &name, CRCImplementation &implementation) noexcept {
+	for (const CRCImplementation candidate : allCRCImplementations) {
+		if (name == getCRCImplementationName(candidate)) {
+			implementation = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Reverse the order of the nrBits least significant bits.
+ */
+template <typename T> constexpr T reflectBits(T value, unsigned int nrBits) noexcept {
+	T reflected = 0;
+	for (unsigned int i = 0; i < nrBits; i++) {
+		if (value & (static_cast<T>(1) << i)) {
+			reflected |= static_cast<T>(1) << (nrBits - 1 - i);
+		}
+	}
+	return reflected;
+}
+
+static constexpr uint64_t byteSwap64(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_bswap64(value);
+#else
+	uint64_t swapped = 0;
+	for (unsigned int i = 0; i < 8; i++) {
+		swapped = (swapped << 8) | ((value >> (i * 8)) & 0xFF);
+	}
+	return swapped;
+#endif
+}
+
+/**
+ * Create the 8-bit lookup table for a CRC, the same layout as CRCpp uses.
+ * Reflected CRCs are stored in the low bits, non-reflected CRCs are aligned to the
+ * most significant bit of CRCType.
+ */
+template <typename CRCType, uint16_t CRCWidth>
+constexpr std::array<CRCType, 256> createCRCTable(CRCType polynomial, bool reflectInput) noexcept {
+	constexpr unsigned int registerBits = sizeof(CRCType) * 8;
+	constexpr unsigned int shift = registerBits - CRCWidth;
+	constexpr CRCType topBit = static_cast<CRCType>(static_cast<CRCType>(1) << (registerBits - 1));
+
+	std::array<CRCType, 256> table{};
+	if (reflectInput) {
+		const CRCType reflectedPolynomial = reflectBits<CRCType>(polynomial, CRCWidth);
+		for (unsigned int i = 0; i < 256; i++) {
+			CRCType crc = static_cast<CRCType>(i);
+			for (unsigned int b = 0; b < 8; b++) {
+				crc = (crc & 1) ? static_cast<CRCType>((crc >> 1) ^ reflectedPolynomial) : static_cast<CRCType>(crc >> 1);
+			}
+			table[i] = crc;
+		}
+	} else {
+		const CRCType alignedPolynomial = static_cast<CRCType>(polynomial << shift);
+		for (unsigned int i = 0; i < 256; i++) {
+			CRCType crc = static_cast<CRCType>(static_cast<CRCType>(i) << (registerBits - 8));
+			for (unsigned int b = 0; b < 8; b++) {
+				crc = (crc & topBit) ? static_cast<CRCType>((crc << 1) ^ alignedPolynomial)
+									 : static_cast<CRCType>(crc << 1);
+			}
+			table[i] = crc;
+		}
+	}
+	return table;
+}
+
+/**
+ * Table driven CRC where every parameter is a compile-time constant, allowing the
+ * compiler to inline and specialize the whole loop per algorithm.
+ */
+template <typename CRCType, uint16_t CRCWidth, CRCType Polynomial, CRCType InitialValue, CRCType FinalXOR,
+		  bool ReflectInput, bool ReflectOutput>
+class CRCTableKernel {
+  public:
+	using Type = CRCType;
+	using Register = CRCType;
+
+	static constexpr uint16_t width = CRCWidth;
+	static constexpr unsigned int registerBits = sizeof(CRCType) * 8;
+	static constexpr unsigned int shift = registerBits - CRCWidth;
+	static constexpr CRCType mask =
+		CRCWidth >= 64 ? static_cast<CRCType>(~static_cast<CRCType>(0))
+					   : static_cast<CRCType>((static_cast<uint64_t>(1) << CRCWidth) - 1);
+
+	static constexpr std::array<CRCType, 256> table = createCRCTable<CRCType, CRCWidth>(Polynomial, ReflectInput);
+
+	static constexpr Register begin() noexcept {
+		if constexpr (ReflectInput) {
+			return reflectBits<CRCType>(InitialValue, CRCWidth);
+		} else {
+			return static_cast<Register>(InitialValue << shift);
+		}
+	}
+
+	static inline Register update(Register crc, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+
+		if constexpr (ReflectInput) {
+			for (size_t i = 0; i < size; i++) {
+				crc = static_cast<Register>((crc >> 8) ^ table[(crc ^ p[i]) & 0xFF]);
+			}
+		} else {
+			for (size_t i = 0; i < size; i++) {
+				crc = static_cast<Register>((crc << 8) ^ table[((crc >> (registerBits - 8)) ^ p[i]) & 0xFF]);
+			}
+		}
+		return crc;
+	}
+
+	static constexpr CRCType end(Register crc) noexcept {
+		CRCType value;
+		if constexpr (ReflectInput) {
+			value = ReflectOutput ? crc : reflectBits<CRCType>(crc, CRCWidth);
+		} else {
+			value = static_cast<CRCType>(crc >> shift);
+			if constexpr (ReflectOutput) {
+				value = reflectBits<CRCType>(value, CRCWidth);
+			}
+		}
+		return static_cast<CRCType>((value ^ FinalXOR) & mask);
+	}
+
+	static inline uint64_t compute(const void *data, size_t size) noexcept {
+		switch (implementation) {
+		case CRCImplementation::SSE42:
+			return end(static_cast<Register>(updateCRC32CSSE42(static_cast<uint32_t>(begin()), data, size)));
+		case CRCImplementation::PCLMUL:
+			return end(updatePCLMUL(data, size));
+		case CRCImplementation::Slicing16:
+			return end(updateSlicing<16>(begin(), data, size));
+		case CRCImplementation::Slicing8:
+			return end(updateSlicing<8>(begin(), data, size));
+		case CRCImplementation::Bytewise:
+		default:
+			return end(update(begin(), data, size));
+		}
+	}
+
+	/**
+	 * Compute the CRC of Lanes messages of nrWords stored interleaved, word i of lane l at
+	 * words[i * stride + l]. The lanes are independent, so their table lookups overlap instead
+	 * of waiting on a single dependency chain. Requires setImplementation to have been called.
+	 */
+	template <unsigned int Lanes>
+	static inline void computeInterleaved(const uint32_t *words, size_t nrWords, size_t stride,
+										  uint64_t *crcs) noexcept {
+		uint64_t wide[Lanes];
+		for (unsigned int lane = 0; lane < Lanes; lane++) {
+			wide[lane] = toWide(begin());
+		}
+
+		for (size_t i = 0; i < nrWords; i++) {
+			const uint32_t *laneWords = &words[i * stride];
+			for (unsigned int lane = 0; lane < Lanes; lane++) {
+				wide[lane] = updateSlicingWord(wide[lane], laneWords[lane]);
+			}
+		}
+
+		for (unsigned int lane = 0; lane < Lanes; lane++) {
+			crcs[lane] = end(fromWide(wide[lane]));
+		}
+	}
+
+	/**
+	 * Implementation used by compute, selected once before any worker starts.
+	 */
+	static inline CRCImplementation implementation = CRCImplementation::Bytewise;
+
+	static constexpr bool isCRC32C = CRCWidth == 32 && Polynomial == 0x1EDC6F41 && ReflectInput;
+
+	static bool isImplementationSupported(CRCImplementation candidate) noexcept {
+		switch (candidate) {
+		case CRCImplementation::Bytewise:
+		case CRCImplementation::Slicing8:
+		case CRCImplementation::Slicing16:
+			return true;
+		case CRCImplementation::PCLMUL:
+			return getCPUFeatures().pclmul;
+		case CRCImplementation::SSE42:
+			return isCRC32C && getCPUFeatures().sse42;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * Select the implementation and create the tables it depends on. Not thread safe.
+	 */
+	static void setImplementation(CRCImplementation selected) noexcept {
+		/*	The slicing tables are also used by the interleaved computation.	*/
+		if (!slicingTableCreated) {
+			createSlicingTable();
+		}
+		if (selected == CRCImplementation::PCLMUL) {
+			foldConstants = createCRCFoldConstants(Polynomial, CRCWidth, ReflectInput);
+		}
+		implementation = selected;
+	}
+
+	/**
+	 * Linear part of the CRC, the output without the initial value and the final XOR.
+	 */
+	static constexpr CRCType residue(Register crc) noexcept { return static_cast<CRCType>(end(crc) ^ FinalXOR); }
+
+	/**
+	 * Compute the CRC contribution of flipping each bit of a message of the given size,
+	 * indexed by byte * 8 + bit. Starts from the last byte and appends one zero byte per
+	 * position, O(size) in total.
+	 */
+	static void computeSyndromes(size_t size, uint64_t *syndromes) noexcept {
+		for (unsigned int bit = 0; bit < 8; bit++) {
+			Register crc = table[1u << bit];
+			for (size_t i = size; i-- > 0;) {
+				syndromes[i * 8 + bit] = residue(crc);
+				crc = update(crc, &zeroByte, 1);
+			}
+		}
+	}
+
+  private:
+	static constexpr uint8_t zeroByte = 0;
+
+	/*	Slicing tables operate on a 64-bit register, reflected CRCs in the low bits and non-reflected
+	 *	CRCs aligned to the most significant bit. Entry [k][b] is byte b followed by k zero bytes.	*/
+	static inline uint64_t slicingTable[16][256];
+	static inline bool slicingTableCreated = false;
+	static inline CRCFoldConstants foldConstants;
+
+	static constexpr unsigned int wideShift = 64 - registerBits;
+
+	static constexpr uint64_t toWide(Register crc) noexcept {
+		if constexpr (ReflectInput) {
+			return crc;
+		} else {
+			return static_cast<uint64_t>(crc) << wideShift;
+		}
+	}
+
+	static constexpr Register fromWide(uint64_t crc) noexcept {
+		if constexpr (ReflectInput) {
+			return static_cast<Register>(crc);
+		} else {
+			return static_cast<Register>(crc >> wideShift);
+		}
+	}
+
+	static void createSlicingTable() noexcept {
+		for (unsigned int b = 0; b < 256; b++) {
+			slicingTable[0][b] = toWide(table[b]);
+		}
+		for (unsigned int k = 1; k < 16; k++) {
+			for (unsigned int b = 0; b < 256; b++) {
+				const uint64_t crc = slicingTable[k - 1][b];
+				if constexpr (ReflectInput) {
+					slicingTable[k][b] = (crc >> 8) ^ slicingTable[0][crc & 0xFF];
+				} else {
+					slicingTable[k][b] = (crc << 8) ^ slicingTable[0][crc >> 56];
+				}
+			}
+		}
+		slicingTableCreated = true;
+	}
+
+	static inline uint64_t loadWord(const uint8_t *p) noexcept {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		if constexpr (!ReflectInput) {
+			/*	Non-reflected CRCs consume the first byte as the most significant.	*/
+			word = byteSwap64(word);
+		}
+		return word;
+	}
+
+	template <unsigned int Slice> static inline uint64_t lookupWord(uint64_t word) noexcept {
+		/*	The first byte of the word is followed by the most bytes.	*/
+		if constexpr (!ReflectInput) {
+			word = byteSwap64(word);
+		}
+		return slicingTable[Slice + 7][word & 0xFF] ^ slicingTable[Slice + 6][(word >> 8) & 0xFF] ^
+			   slicingTable[Slice + 5][(word >> 16) & 0xFF] ^ slicingTable[Slice + 4][(word >> 24) & 0xFF] ^
+			   slicingTable[Slice + 3][(word >> 32) & 0xFF] ^ slicingTable[Slice + 2][(word >> 40) & 0xFF] ^
+			   slicingTable[Slice + 1][(word >> 48) & 0xFF] ^ slicingTable[Slice][word >> 56];
+	}
+
+	/**
+	 * Slicing-by-4 update of the wide register with a little-endian message word.
+	 */
+	static inline uint64_t updateSlicingWord(uint64_t crc, uint32_t word) noexcept {
+		if constexpr (ReflectInput) {
+			const uint64_t x = crc ^ word;
+			return (x >> 32) ^ slicingTable[3][x & 0xFF] ^ slicingTable[2][(x >> 8) & 0xFF] ^
+				   slicingTable[1][(x >> 16) & 0xFF] ^ slicingTable[0][(x >> 24) & 0xFF];
+		} else {
+			const uint64_t x = crc ^ byteSwap64(word);
+			return (x << 32) ^ slicingTable[3][x >> 56] ^ slicingTable[2][(x >> 48) & 0xFF] ^
+				   slicingTable[1][(x >> 40) & 0xFF] ^ slicingTable[0][(x >> 32) & 0xFF];
+		}
+	}
+
+	template <unsigned int Slices>
+	static inline Register updateSlicing(Register crc, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+		uint64_t wide = toWide(crc);
+
+		for (; size >= Slices; size -= Slices, p += Slices) {
+			if constexpr (Slices == 16) {
+				wide = lookupWord<8>(wide ^ loadWord(p)) ^ lookupWord<0>(loadWord(p + 8));
+			} else {
+				wide = lookupWord<0>(wide ^ loadWord(p));
+			}
+		}
+		return update(fromWide(wide), p, size);
+	}
+
+	static inline Register updatePCLMUL(const void *data, size_t size) noexcept {
+		if (size < pclmulMinSize) {
+			return updateSlicing<16>(begin(), data, size);
+		}
+
+		/*	The initial register is XORed into the first bytes of the message, in message byte order.	*/
+		uint64_t initialXOR = toWide(begin());
+		if constexpr (!ReflectInput) {
+			initialXOR = byteSwap64(initialXOR);
+		}
+
+		uint8_t remainder[16];
+		const size_t consumed = foldCRCPCLMUL(data, size, initialXOR, foldConstants, remainder);
+
+		const Register crc = updateSlicing<16>(0, remainder, sizeof(remainder));
+		return updateSlicing<16>(crc, static_cast<const uint8_t *>(data) + consumed, size - consumed);
+	}
+};
+
+/**
+ * XOR checksum over every Result sized word of the message.
+ */
+template <typename Result, Result Mask> class XORKernel {
+  public:
+	using Type = Result;
+	using Register = Result;
+
+	static constexpr uint16_t width = sizeof(Result) * 8;
+
+	static constexpr Register begin() noexcept { return 0; }
+
+	static inline Register update(Register checksum, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+
+		for (size_t i = 0; i < size / sizeof(Result); i++) {
+			Result word;
+			std::memcpy(&word, &p[i * sizeof(Result)], sizeof(Result));
+			checksum ^= word;
+		}
+		return checksum;
+	}
+
+	static constexpr Result end(Register checksum) noexcept { return checksum & Mask; }
+
+	static inline uint64_t compute(const void *data, size_t size) noexcept { return end(update(begin(), data, size)); }
+
+	template <unsigned int Lanes>
+	static inline void computeInterleaved(const uint32_t *words, size_t nrWords, size_t stride,
+										  uint64_t *crcs) noexcept {
+		uint32_t checksum[Lanes] = {};
+		for (size_t i = 0; i < nrWords; i++) {
+			for (unsigned int lane = 0; lane < Lanes; lane++) {
+				checksum[lane] ^= words[i * stride + lane];
+			}
+		}
+
+		/*	Fold each 32-bit lane checksum down to the Result size.	*/
+		for (unsigned int lane = 0; lane < Lanes; lane++) {
+			crcs[lane] = end(update(begin(), &checksum[lane], sizeof(checksum[lane])));
+		}
+	}
+
+	static inline CRCImplementation implementation = CRCImplementation::Bytewise;
+
+	static bool isImplementationSupported(CRCImplementation candidate) noexcept {
+		return candidate == CRCImplementation::Bytewise;
+	}
+
+	static void setImplementation(CRCImplementation selected) noexcept { implementation = selected; }
+
+	static constexpr Result residue(Register checksum) noexcept { return end(checksum); }
+
+	static void computeSyndromes(size_t size, uint64_t *syndromes) noexcept {
+		const size_t nrCoveredBytes = (size / sizeof(Result)) * sizeof(Result);
+
+		for (size_t i = 0; i < size * 8; i++) {
+			/*	Trailing bytes that do not fill a whole word are not part of the checksum.	*/
+			const Result bit = static_cast<Result>(static_cast<Result>(1) << (i % width));
+			syndromes[i] = i / 8 < nrCoveredBytes ? end(bit) : 0;
+		}
+	}
+};
+
+/**
+ * Parameters of a CRC in the Rocksoft model, the polynomial in the normal form without the x^width term.
+ */
+struct CRCParameters {
+	uint64_t polynomial;
+	unsigned int width;
+	uint64_t initialValue;
+	uint64_t finalXOR;
+	bool reflectInput;
+	bool reflectOutput;
+};
+
+/**
+ * Table driven CRC with the parameters given at run time, for the polynomials that are not one of the
+ * predefined algorithms. The register is 64 bits, reflected CRCs in the low bits and non-reflected CRCs
+ * aligned to the most significant bit. The parameters are set once before any worker starts.
+ */
+class CRCCustomKernel {
+  public:
+	using Type = uint64_t;
+	using Register = uint64_t;
+
+	static inline uint16_t width = 64;
+
+	/**
+	 * Set the parameters and create the tables. Not thread safe.
+	 */
+	static void setParameters(const CRCParameters &selected) noexcept {
+		parameters = selected;
+		width = static_cast<uint16_t>(selected.width);
+		shift = 64 - selected.width;
+		mask = selected.width >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << selected.width) - 1;
+
+		if (selected.reflectInput) {
+			const uint64_t reflectedPolynomial = reflectBits<uint64_t>(selected.polynomial, selected.width);
+			for (unsigned int i = 0; i < 256; i++) {
+				uint64_t crc = i;
+				for (unsigned int b = 0; b < 8; b++) {
+					crc = (crc & 1) ? (crc >> 1) ^ reflectedPolynomial : crc >> 1;
+				}
+				slicingTable[0][i] = crc;
+			}
+		} else {
+			const uint64_t alignedPolynomial = selected.polynomial << shift;
+			for (unsigned int i = 0; i < 256; i++) {
+				uint64_t crc = static_cast<uint64_t>(i) << 56;
+				for (unsigned int b = 0; b < 8; b++) {
+					crc = (crc >> 63) ? (crc << 1) ^ alignedPolynomial : crc << 1;
+				}
+				slicingTable[0][i] = crc;
+			}
+		}
+		for (unsigned int k = 1; k < 8; k++) {
+			for (unsigned int b = 0; b < 256; b++) {
+				const uint64_t crc = slicingTable[k - 1][b];
+				slicingTable[k][b] = selected.reflectInput ? (crc >> 8) ^ slicingTable[0][crc & 0xFF]
+														   : (crc << 8) ^ slicingTable[0][crc >> 56];
+			}
+		}
+	}
+
+	static const CRCParameters &getParameters() noexcept { return parameters; }
+
+	static inline Register begin() noexcept {
+		return parameters.reflectInput ? reflectBits<uint64_t>(parameters.initialValue, parameters.width)
+									   : parameters.initialValue << shift;
+	}
+
+	static inline Register update(Register crc, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+
+		if (parameters.reflectInput) {
+			for (size_t i = 0; i < size; i++) {
+				crc = (crc >> 8) ^ slicingTable[0][(crc ^ p[i]) & 0xFF];
+			}
+		} else {
+			for (size_t i = 0; i < size; i++) {
+				crc = (crc << 8) ^ slicingTable[0][(crc >> 56) ^ p[i]];
+			}
+		}
+		return crc;
+	}
+
+	static inline uint64_t end(Register crc) noexcept {
+		uint64_t value;
+		if (parameters.reflectInput) {
+			value = parameters.reflectOutput ? crc : reflectBits<uint64_t>(crc, parameters.width);
+		} else {
+			value = crc >> shift;
+			if (parameters.reflectOutput) {
+				value = reflectBits<uint64_t>(value, parameters.width);
+			}
+		}
+		return (value ^ parameters.finalXOR) & mask;
+	}
+
+	static inline uint64_t compute(const void *data, size_t size) noexcept {
+		if (implementation == CRCImplementation::Slicing8) {
+			return end(updateSlicing8(begin(), data, size));
+		}
+		return end(update(begin(), data, size));
+	}
+
+	template <unsigned int Lanes>
+	static inline void computeInterleaved(const uint32_t *words, size_t nrWords, size_t stride,
+										  uint64_t *crcs) noexcept {
+		Register crc[Lanes];
+		for (unsigned int lane = 0; lane < Lanes; lane++) {
+			crc[lane] = begin();
+		}
+		for (size_t i = 0; i < nrWords; i++) {
+			const uint32_t *laneWords = &words[i * stride];
+			for (unsigned int lane = 0; lane < Lanes; lane++) {
+				crc[lane] = update(crc[lane], &laneWords[lane], sizeof(uint32_t));
+			}
+		}
+		for (unsigned int lane = 0; lane < Lanes; lane++) {
+			crcs[lane] = end(crc[lane]);
+		}
+	}
+
+	static inline CRCImplementation implementation = CRCImplementation::Bytewise;
+
+	static bool isImplementationSupported(CRCImplementation candidate) noexcept {
+		return candidate == CRCImplementation::Bytewise || candidate == CRCImplementation::Slicing8;
+	}
+
+	static void setImplementation(CRCImplementation selected) noexcept { implementation = selected; }
+
+	static inline uint64_t residue(Register crc) noexcept { return end(crc) ^ parameters.finalXOR; }
+
+	static void computeSyndromes(size_t size, uint64_t *syndromes) noexcept {
+		for (unsigned int bit = 0; bit < 8; bit++) {
+			Register crc = slicingTable[0][1u << bit];
+			for (size_t i = size; i-- > 0;) {
+				syndromes[i * 8 + bit] = residue(crc);
+				crc = update(crc, &zeroByte, 1);
+			}
+		}
+	}
+
+  private:
+	static constexpr uint8_t zeroByte = 0;
+
+	static inline CRCParameters parameters = {0, 64, 0, 0, false, false};
+	static inline unsigned int shift = 0;
+	static inline uint64_t mask = ~static_cast<uint64_t>(0);
+	/*	Entry [k][b] is byte b followed by k zero bytes.	*/
+	static inline uint64_t slicingTable[8][256];
+
+	static inline Register updateSlicing8(Register crc, const void *data, size_t size) noexcept {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+
+		for (; size >= 8; size -= 8, p += 8) {
+			uint64_t word;
+			std::memcpy(&word, p, sizeof(word));
+			if (parameters.reflectInput) {
+				word ^= crc;
+			} else {
+				/*	The first byte of the word is followed by the most bytes.	*/
+				word = byteSwap64(word) ^ crc;
+				word = byteSwap64(word);
+			}
+			crc = slicingTable[7][word & 0xFF] ^ slicingTable[6][(word >> 8) & 0xFF] ^
+				  slicingTable[5][(word >> 16) & 0xFF] ^ slicingTable[4][(word >> 24) & 0xFF] ^
+				  slicingTable[3][(word >> 32) & 0xFF] ^ slicingTable[2][(word >> 40) & 0xFF] ^
+				  slicingTable[1][(word >> 48) & 0xFF] ^ slicingTable[0][word >> 56];
+		}
+		return update(crc, p, size);
+	}
+};
+
+/**
+ * Select the last implementation in the order of CRCImplementation that the kernel supports on the CPU.
+ */
+template <typename Kernel> CRCImplementation selectCRCImplementation() noexcept {
+	CRCImplementation selected = CRCImplementation::Bytewise;
+	for (const CRCImplementation candidate :
+		 {CRCImplementation::Slicing8, CRCImplementation::Slicing16, CRCImplementation::PCLMUL,
+		  CRCImplementation::SSE42}) {
+		if (Kernel::isImplementationSupported(candidate)) {
+			selected = candidate;
+		}
+	}
+	Kernel::setImplementation(selected);
+	return selected;
+}
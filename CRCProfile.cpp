@@ -0,0 +1,79 @@
+#include "CRCProfile.h"
+#include <algorithm>
+
+static const char *const samplePhaseNames[nrSamplePhases] = {"message", "error", "crc", "error-crc", "compare"};
+
+/*	Ticks of reading the profile clock, which every phase includes once.	*/
+static double measureProfileReadTicks() noexcept {
+	constexpr unsigned int nrReads = 4096;
+	const uint64_t first = readProfileTicks();
+	uint64_t last = first;
+	for (unsigned int i = 0; i < nrReads; i++) {
+		last = readProfileTicks();
+	}
+	return (double)(last - first) / nrReads;
+}
+
+SampleProfiler::SampleProfiler(uint32_t interval, uint32_t nrTasks)
+	: profiles(nrTasks), readTicks(measureProfileReadTicks()), startTicks(readProfileTicks()),
+	  start(std::chrono::steady_clock::now()) {
+	for (SampleProfile &profile : profiles) {
+		profile.interval = std::max(1u, interval);
+	}
+}
+
+void SampleProfiler::print(FILE *file, const std::string &algorithm, uint64_t messageSize,
+						   const ShardedCounters &counters) const {
+	const double elapsedNanoSeconds =
+		std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	const double ticksPerNanoSecond =
+		elapsedNanoSeconds > 0 ? (double)(readProfileTicks() - startTicks) / elapsedNanoSeconds : 1;
+
+	uint64_t nrTimed = 0;
+	double phaseTicks[nrSamplePhases] = {}, totalTicks = 0;
+	for (const SampleProfile &profile : profiles) {
+		for (unsigned int phase = 0; phase < nrSamplePhases; phase++) {
+			phaseTicks[phase] += profile.phaseTicks[phase];
+		}
+		nrTimed += profile.nrTimed;
+	}
+	for (unsigned int phase = 0; phase < nrSamplePhases; phase++) {
+		phaseTicks[phase] = std::max(0.0, phaseTicks[phase] - readTicks * nrTimed);
+		totalTicks += phaseTicks[phase];
+	}
+
+	fprintf(file, "Profile: %s, message-data-size %lu, %lu samples timed, one in %u\n", algorithm.c_str(),
+			(unsigned long)messageSize, (unsigned long)nrTimed, profiles.empty() ? 1 : profiles.front().interval);
+	if (nrTimed == 0) {
+		return;
+	}
+	fprintf(file, "%-12s %12s %12s %8s\n", "phase", "ns/sample", (std::string("B/") + profileTickName).c_str(),
+			"share");
+	for (unsigned int phase = 0; phase <= nrSamplePhases; phase++) {
+		const double ticks = phase < nrSamplePhases ? phaseTicks[phase] : totalTicks;
+		const double ticksPerSample = ticks / (double)nrTimed;
+		fprintf(file, "%-12s %12.2f %12.3f %7.1f%%\n", phase < nrSamplePhases ? samplePhaseNames[phase] : "total",
+				ticksPerSample / ticksPerNanoSecond, ticksPerSample > 0 ? (double)messageSize / ticksPerSample : 0,
+				totalTicks > 0 ? 100.0 * ticks / totalTicks : 0);
+	}
+
+	/*	The imbalance is the excess of the busiest worker over the mean busy time.	*/
+	double totalBusy = 0, maxBusy = 0;
+	unsigned int nrWorkers = 0;
+	for (unsigned int i = 0; i < counters.getNrShards(); i++) {
+		const CounterShard &shard = counters.getShard(i);
+		const uint64_t nrSamples = shard.nrSamples.load(std::memory_order_relaxed);
+		if (nrSamples == 0) {
+			continue;
+		}
+		const double busy = shard.busyNanoSeconds.load(std::memory_order_relaxed) * 1e-9;
+		fprintf(file, "Worker %u: %lu samples, busy %.3f s, %.2f ns/sample\n", i, (unsigned long)nrSamples, busy,
+				busy * 1e9 / (double)nrSamples);
+		totalBusy += busy;
+		maxBusy = std::max(maxBusy, busy);
+		nrWorkers++;
+	}
+	if (nrWorkers > 0 && totalBusy > 0) {
+		fprintf(file, "Load imbalance: %.1f%%\n", 100.0 * (maxBusy * nrWorkers / totalBusy - 1));
+	}
+}
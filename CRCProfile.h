@@ -0,0 +1,109 @@
+#pragma once
+#include "CRCCounters.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <ctime>
+#endif
+
+/*	Phases of sampling a message, in the order they run: drawing the message, drawing the error, the CRC of
+ *	the message, the CRC of the error message and comparing them.	*/
+enum class SamplePhase { Message, Error, CRC, ErrorCRC, Compare };
+static constexpr unsigned int nrSamplePhases = 5;
+
+/*	Unit of the profile clock.	*/
+#if defined(__x86_64__) || defined(__i386__)
+static constexpr const char *profileTickName = "cycle";
+#else
+static constexpr const char *profileTickName = "ns";
+#endif
+
+/**
+ * Profile clock, the time stamp counter in reference cycles on x86 and nanoseconds elsewhere. The counter is
+ * not serializing, the phases of a single sample overlap by a few instructions.
+ */
+static inline uint64_t readProfileTicks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+#endif
+}
+
+/**
+ * Ticks spent in every phase by the timed samples of a single task, padded to its own cache line.
+ */
+struct alignas(64) SampleProfile {
+	uint64_t phaseTicks[nrSamplePhases] = {};
+	uint64_t nrTimed = 0;
+	uint32_t interval = 1; /*	One in interval samples is timed.	*/
+	uint32_t countdown = 0; /*	Samples until the next timed one.	*/
+};
+
+/**
+ * Times the phases of a sample, if it is timed. Compiles to nothing unless enabled, so that the sampling loop
+ * pays nothing for the profiler when it is disabled.
+ */
+template <bool enabled> class SamplePhaseTimer {
+  public:
+	explicit SamplePhaseTimer(SampleProfile *profile) noexcept {
+		if (enabled) {
+			if (profile->countdown == 0) {
+				profile->countdown = profile->interval;
+				this->profile = profile;
+				last = readProfileTicks();
+			}
+			profile->countdown--;
+		}
+	}
+
+	~SamplePhaseTimer() {
+		if (enabled && profile != nullptr) {
+			profile->nrTimed++;
+		}
+	}
+
+	/**
+	 * End the phase, the next one starts.
+	 */
+	void mark(SamplePhase phase) noexcept {
+		if (enabled && profile != nullptr) {
+			const uint64_t now = readProfileTicks();
+			profile->phaseTicks[static_cast<unsigned int>(phase)] += now - last;
+			last = now;
+		}
+	}
+
+  private:
+	SampleProfile *profile = nullptr;
+	uint64_t last = 0;
+};
+
+/**
+ * Phase profile of a sampling run, one profile per task. The ticks are converted to nanoseconds with the tick
+ * rate measured over the whole run, less the cost of reading the clock measured at the start.
+ */
+class SampleProfiler {
+  public:
+	SampleProfiler(uint32_t interval, uint32_t nrTasks);
+
+	SampleProfile *getTaskProfile(uint32_t nthTask) noexcept { return &profiles[nthTask]; }
+
+	/**
+	 * Print the time per sample and bytes per tick of every phase, and the load of every worker thread.
+	 */
+	void print(FILE *file, const std::string &algorithm, uint64_t messageSize, const ShardedCounters &counters) const;
+
+  private:
+	std::vector<SampleProfile> profiles;
+	const double readTicks;
+	const uint64_t startTicks;
+	const std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,395 @@
+#include "CRCResults.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+bool parseResultFormat(const std::string &name, ResultFormat &format) {
+	if (name == "text") {
+		format = ResultFormat::Text;
+	} else if (name == "csv") {
+		format = ResultFormat::CSV;
+	} else if (name == "jsonl") {
+		format = ResultFormat::JSONL;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+/*	Set the field of the record named by a CSV column or JSON key, the derived columns are ignored.	*/
+static void setRecordField(ResultRecord &record, const std::string &name, const std::string &value) {
+	const char *text = value.c_str();
+	if (name == "type") {
+		record.type = value;
+	} else if (name == "algorithm") {
+		record.algorithm = value;
+	} else if (name == "message_size") {
+		record.messageSize = strtoull(text, nullptr, 10);
+	} else if (name == "bit_errors") {
+		record.nrBitError = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	} else if (name == "probability") {
+		record.probability = strtof(text, nullptr);
+	} else if (name == "seed") {
+		record.seed = strtoull(text, nullptr, 10);
+	} else if (name == "task") {
+		record.task = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	} else if (name == "tasks") {
+		record.nrTasks = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	} else if (name == "samples") {
+		record.samples = strtoull(text, nullptr, 10);
+	} else if (name == "collisions") {
+		record.collisions = strtoull(text, nullptr, 10);
+	} else if (name == "wall_time") {
+		record.wallTime = strtod(text, nullptr);
+	} else if (name == "effective_samples") {
+		record.effectiveSamples = strtod(text, nullptr);
+	} else if (name == "burst_length") {
+		record.burstLength = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	} else if (name == "corrected") {
+		record.nrCorrected = strtoull(text, nullptr, 10);
+	} else if (name == "miscorrected") {
+		record.nrMiscorrected = strtoull(text, nullptr, 10);
+	} else if (name == "uncorrectable") {
+		record.nrUncorrectable = strtoull(text, nullptr, 10);
+	} else if (name == "error_free") {
+		record.nrErrorFree = strtoull(text, nullptr, 10);
+	} else if (name == "shard") {
+		record.shard = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	} else if (name == "shards") {
+		record.nrShards = static_cast<uint32_t>(strtoul(text, nullptr, 10));
+	}
+}
+
+/*	Parse a flat JSON object of strings and numbers, as written by ResultsWriter, whose strings have no escapes.	*/
+static bool parseJSONRecord(const std::string &line, ResultRecord &record) {
+	size_t i = line.find_first_not_of(" \t");
+	if (i == std::string::npos || line[i] != '{') {
+		return false;
+	}
+	i++;
+	while (true) {
+		i = line.find_first_not_of(" \t", i);
+		if (i == std::string::npos || line[i] != '"') {
+			return false;
+		}
+		const size_t keyEnd = line.find('"', i + 1);
+		if (keyEnd == std::string::npos) {
+			return false;
+		}
+		const std::string key = line.substr(i + 1, keyEnd - i - 1);
+		i = line.find_first_not_of(" \t", keyEnd + 1);
+		if (i == std::string::npos || line[i] != ':') {
+			return false;
+		}
+		i = line.find_first_not_of(" \t", i + 1);
+		if (i == std::string::npos) {
+			return false;
+		}
+
+		size_t valueEnd;
+		if (line[i] == '"') {
+			valueEnd = line.find('"', i + 1);
+			if (valueEnd == std::string::npos) {
+				return false;
+			}
+			setRecordField(record, key, line.substr(i + 1, valueEnd - i - 1));
+			valueEnd++;
+		} else {
+			valueEnd = line.find_first_of(",} \t", i);
+			if (valueEnd == std::string::npos) {
+				return false;
+			}
+			setRecordField(record, key, line.substr(i, valueEnd - i));
+		}
+
+		i = line.find_first_not_of(" \t", valueEnd);
+		if (i == std::string::npos) {
+			return false;
+		}
+		if (line[i] == '}') {
+			return true;
+		}
+		if (line[i] != ',') {
+			return false;
+		}
+		i++;
+	}
+}
+
+static void splitCSVLine(const std::string &line, std::vector<std::string> &fields) {
+	fields.clear();
+	size_t begin = 0;
+	while (true) {
+		const size_t end = line.find(',', begin);
+		fields.push_back(line.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+		if (end == std::string::npos) {
+			return;
+		}
+		begin = end + 1;
+	}
+}
+
+bool readResultRecords(const std::string &path, std::vector<ResultRecord> &records) {
+	std::ifstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	std::string line;
+	std::vector<std::string> columns, fields;
+	bool isCSV = false;
+	uint64_t lineNumber = 0;
+	while (std::getline(file, line)) {
+		lineNumber++;
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (line.empty()) {
+			continue;
+		}
+
+		if (lineNumber == 1 && line.compare(0, 5, "type,") == 0) {
+			splitCSVLine(line, columns);
+			isCSV = true;
+			continue;
+		}
+
+		ResultRecord record{"", "", 0, 0, 0, 0, 0, 1, 0, 0, 0};
+		bool parsed;
+		if (isCSV) {
+			splitCSVLine(line, fields);
+			parsed = fields.size() == columns.size();
+			for (size_t i = 0; parsed && i < fields.size(); i++) {
+				setRecordField(record, columns[i], fields[i]);
+			}
+		} else {
+			parsed = parseJSONRecord(line, record);
+		}
+
+		if (!parsed || record.type.empty()) {
+			throw std::invalid_argument("Malformed results " + path + " at line " + std::to_string(lineNumber) +
+										", expected the csv or jsonl output format");
+		}
+		records.push_back(std::move(record));
+	}
+	return true;
+}
+
+ResultsWriter::ResultsWriter(ResultFormat format, FILE *file, double z, uint32_t shard, uint32_t nrShards)
+	: format(format), file(file), z(z), shard(shard), nrShards(nrShards) {
+	if (format == ResultFormat::CSV) {
+		fputs("type,algorithm,message_size,bit_errors,probability,seed,task,tasks,samples,collisions,rate,ci_lower,"
+			  "ci_upper,wall_time,samples_per_sec,effective_samples,burst_length,corrected,miscorrected,"
+			  "uncorrectable,error_free,shard,shards\n",
+			  file);
+	}
+	thread = std::thread([this] { run(); });
+}
+
+ResultsWriter::~ResultsWriter() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	pendingChanged.notify_all();
+	thread.join();
+
+	if (progressPending) {
+		fputc('\n', file);
+	}
+	fflush(file);
+}
+
+void ResultsWriter::write(ResultRecord record) {
+	record.shard = shard;
+	record.nrShards = nrShards;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(std::move(record));
+		nrQueued++;
+	}
+	pendingChanged.notify_all();
+}
+
+void ResultsWriter::flush() {
+	std::unique_lock<std::mutex> lock(mutex);
+	const uint64_t target = nrQueued;
+	pendingChanged.wait(lock, [&] { return nrWritten >= target; });
+}
+
+void ResultsWriter::run() {
+	std::vector<ResultRecord> batch;
+	std::string out;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			pendingChanged.wait(lock, [&] { return stopping || !pending.empty(); });
+			if (pending.empty()) {
+				return;
+			}
+			batch.swap(pending);
+		}
+
+		/*	Format the whole batch and write it at once.	*/
+		out.clear();
+		for (const ResultRecord &record : batch) {
+			formatRecord(record, out);
+		}
+		fwrite(out.data(), 1, out.size(), file);
+		fflush(file);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			nrWritten += batch.size();
+		}
+		batch.clear();
+		pendingChanged.notify_all();
+	}
+}
+
+void ResultsWriter::formatRecord(const ResultRecord &record, std::string &out) {
+	char line[512];
+	const bool isImportance = record.type == "importance";
+	const bool isExact = record.type == "exhaustive" || record.type == "analytic" || record.type == "weight" ||
+						 record.type == "search" || record.type == "burst";
+	double rate = record.samples > 0 ? (double)record.collisions / (double)record.samples : 0;
+	if (isImportance || record.type == "analytic" || record.type == "weight") {
+		rate = record.estimate;
+	}
+
+	if (format == ResultFormat::Text) {
+		if (record.type == "task") {
+			return;
+		}
+		/*	Records without a bit error count are of bursts, or of a channel with a bit error rate.	*/
+		char errorLabel[64];
+		if (record.burstLength > 0) {
+			snprintf(errorLabel, sizeof(errorLabel), "burst-length %u", record.burstLength);
+		} else if (record.nrBitError == 0) {
+			snprintf(errorLabel, sizeof(errorLabel), "bit-error-rate %g", record.probability);
+		} else {
+			snprintf(errorLabel, sizeof(errorLabel), "nr-error-bit %u", record.nrBitError);
+		}
+
+		if (record.type == "progress") {
+			const double _progressPerc =
+				record.targetSamples > 0 ? 100.0 * (double)record.samples / (double)record.targetSamples : 0;
+			if (record.algorithm.empty()) {
+				snprintf(line, sizeof(line), "\rProgress: [%.1lf%%] NumberOfSamples %lu", _progressPerc,
+						 (unsigned long)record.samples);
+			} else {
+				snprintf(line, sizeof(line),
+						 "\rCRC: %s, [%.1lf%%] NumberOfSamples %lu, collision - count: %lu perc: %lf - %s",
+						 record.algorithm.c_str(), _progressPerc, (unsigned long)record.samples,
+						 (unsigned long)record.collisions, rate, errorLabel);
+			}
+			out += line;
+			progressPending = true;
+			return;
+		}
+
+		if (progressPending) {
+			out += '\n';
+			progressPending = false;
+		}
+		if (record.type == "worker") {
+			const double samplesPerSec = record.wallTime > 0 ? (double)record.samples / record.wallTime : 0;
+			snprintf(line, sizeof(line), "Worker %u: NumberOfSamples %lu, samples/sec %.3e\n", record.task,
+					 (unsigned long)record.samples, samplesPerSec);
+		} else if (isImportance) {
+			snprintf(line, sizeof(line),
+					 "CRC: %s, message-data-size %lu, NumberOfSamples %lu, hits %lu - nr-error-bit %u, estimate %.6e "
+					 "standard-error %.3e, effective-samples %.1lf\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, (unsigned long)record.samples,
+					 (unsigned long)record.collisions, record.nrBitError, record.estimate, record.standardError,
+					 record.effectiveSamples);
+		} else if (record.type == "analytic" && record.nrBitError == 0) {
+			snprintf(line, sizeof(line), "CRC: %s, message-data-size %lu, bit-error-rate %g: analytic perc: %.12e\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, record.probability, rate);
+		} else if (record.type == "analytic") {
+			snprintf(line, sizeof(line), "CRC: %s, message-data-size %lu, nr-error-bit %u: analytic perc: %.12e\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, record.nrBitError, rate);
+		} else if (record.type == "weight") {
+			snprintf(line, sizeof(line), "CRC: %s, message-data-size %lu, weight %u: undetected fraction %.12e\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, record.nrBitError, rate);
+		} else if (record.type == "search") {
+			/*	No undetected pattern up to the largest evaluated weight.	*/
+			snprintf(line, sizeof(line),
+					 "Rank %u: polynomial %s, message-data-size %lu, hamming-distance %s%u, undetected %lu\n",
+					 record.task + 1, record.algorithm.c_str(), (unsigned long)record.messageSize,
+					 record.collisions == 0 ? ">= " : "", record.nrBitError, (unsigned long)record.collisions);
+		} else if (record.type == "burst") {
+			snprintf(line, sizeof(line),
+					 "CRC: %s, message-data-size %lu, burst-length %u: bursts %lu, undetected %lu perc: %.12lf\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, record.burstLength,
+					 (unsigned long)record.samples, (unsigned long)record.collisions, rate);
+		} else if (record.type == "correction") {
+			const double nrSamples = record.samples > 0 ? (double)record.samples : 1;
+			snprintf(line, sizeof(line),
+					 "CRC: %s, message-data-size %lu, NumberOfSamples %lu - %s: corrected %lu perc: %lf, miscorrected "
+					 "%lu perc: %lf, uncorrectable %lu perc: %lf, undetected %lu perc: %lf, error-free %lu perc: %lf\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, (unsigned long)record.samples,
+					 errorLabel, (unsigned long)record.nrCorrected, record.nrCorrected / nrSamples,
+					 (unsigned long)record.nrMiscorrected, record.nrMiscorrected / nrSamples,
+					 (unsigned long)record.nrUncorrectable, record.nrUncorrectable / nrSamples,
+					 (unsigned long)record.collisions, rate, (unsigned long)record.nrErrorFree,
+					 record.nrErrorFree / nrSamples);
+		} else if (record.type == "exhaustive") {
+			snprintf(line, sizeof(line),
+					 "CRC: %s, message-data-size %lu, nr-error-bit %u: patterns %lu, undetected %lu perc: %.12lf\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, record.nrBitError,
+					 (unsigned long)record.samples, (unsigned long)record.collisions, rate);
+		} else {
+			const ConfidenceInterval interval = computeConfidenceInterval(record.collisions, record.samples, z);
+			snprintf(line, sizeof(line),
+					 "CRC: %s, message-data-size %lu, NumberOfSamples %lu, collision - count: %lu perc: %lf - "
+					 "%s, interval [%.3e, %.3e]\n",
+					 record.algorithm.c_str(), (unsigned long)record.messageSize, (unsigned long)record.samples,
+					 (unsigned long)record.collisions, rate, errorLabel, interval.lower, interval.upper);
+		}
+		out += line;
+		return;
+	}
+
+	/*	Exhaustive counts and analytic rates are exact, importance estimates get a normal interval from their
+	 *	standard error.	*/
+	ConfidenceInterval interval;
+	if (isExact) {
+		interval = {rate, rate};
+	} else if (isImportance) {
+		interval = {std::max(0.0, rate - z * record.standardError), rate + z * record.standardError};
+	} else {
+		interval = computeConfidenceInterval(record.collisions, record.samples, z);
+	}
+	const double samplesPerSec = record.wallTime > 0 ? (double)record.samples / record.wallTime : 0;
+	const double effectiveSamples = isImportance ? record.effectiveSamples : (double)record.samples;
+
+	if (format == ResultFormat::CSV) {
+		snprintf(line, sizeof(line),
+				 "%s,%s,%lu,%u,%.9g,%lu,%u,%u,%lu,%lu,%.9e,%.9e,%.9e,%.6f,%.6e,%.1f,%u,%lu,%lu,%lu,%lu,%u,%u\n",
+				 record.type.c_str(), record.algorithm.c_str(), (unsigned long)record.messageSize, record.nrBitError,
+				 record.probability, (unsigned long)record.seed, record.task, record.nrTasks,
+				 (unsigned long)record.samples, (unsigned long)record.collisions, rate, interval.lower, interval.upper,
+				 record.wallTime, samplesPerSec, effectiveSamples, record.burstLength,
+				 (unsigned long)record.nrCorrected, (unsigned long)record.nrMiscorrected,
+				 (unsigned long)record.nrUncorrectable, (unsigned long)record.nrErrorFree, record.shard,
+				 record.nrShards);
+	} else {
+		snprintf(line, sizeof(line),
+				 "{\"type\":\"%s\",\"algorithm\":\"%s\",\"message_size\":%lu,\"bit_errors\":%u,\"probability\":%.9g,"
+				 "\"seed\":%lu,\"task\":%u,\"tasks\":%u,\"samples\":%lu,\"collisions\":%lu,\"rate\":%.9e,"
+				 "\"ci_lower\":%.9e,\"ci_upper\":%.9e,\"wall_time\":%.6f,\"samples_per_sec\":%.6e,"
+				 "\"effective_samples\":%.1f,\"burst_length\":%u,\"corrected\":%lu,\"miscorrected\":%lu,"
+				 "\"uncorrectable\":%lu,\"error_free\":%lu,\"shard\":%u,\"shards\":%u}\n",
+				 record.type.c_str(), record.algorithm.c_str(), (unsigned long)record.messageSize, record.nrBitError,
+				 record.probability, (unsigned long)record.seed, record.task, record.nrTasks,
+				 (unsigned long)record.samples, (unsigned long)record.collisions, rate, interval.lower, interval.upper,
+				 record.wallTime, samplesPerSec, effectiveSamples, record.burstLength,
+				 (unsigned long)record.nrCorrected, (unsigned long)record.nrMiscorrected,
+				 (unsigned long)record.nrUncorrectable, (unsigned long)record.nrErrorFree, record.shard,
+				 record.nrShards);
+	}
+	out += line;
+}
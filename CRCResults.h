@@ -0,0 +1,112 @@
+#pragma once
+#include "CRCStatistics.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ResultFormat { Text, CSV, JSONL };
+
+extern bool parseResultFormat(const std::string &name, ResultFormat &format);
+
+/**
+ * Outcome of a task, progress of a run, the final outcome of a run, the totals of a worker thread, an
+ * exhaustive count, an importance sampling estimate, an analytic probability, a ranked polynomial of a search,
+ * an exhaustive burst count or the outcomes of the error correction.
+ * Progress records spanning several algorithms have no algorithm and no collisions.
+ */
+struct ResultRecord {
+	/*	task, progress, final, worker, exhaustive, importance, analytic, weight, search, burst or correction.	*/
+	std::string type;
+	/*	The algorithm, or the polynomial for search records, whose Hamming distance is in nrBitError and the
+	 *	number of undetected patterns of that weight in collisions.	*/
+	std::string algorithm;
+	uint64_t messageSize; /*	In bytes.	*/
+	uint32_t nrBitError; /*	0 for a channel, whose bit error rate is in probability, and for bursts.	*/
+	float probability;
+	uint64_t seed;
+	uint32_t task; /*	Index of the task, or of the worker thread for worker records.	*/
+	uint32_t nrTasks;
+	uint64_t samples;
+	uint64_t collisions;
+	double wallTime; /*	In seconds, the busy time for task and worker records.	*/
+	uint64_t targetSamples = 0; /*	Samples of the whole run, for progress records.	*/
+	/*	Weighted estimate of the rate, its standard error and the effective sample size, for importance records.
+	 *	The exact rate for analytic and weight records.	*/
+	double estimate = 0;
+	double standardError = 0;
+	double effectiveSamples = 0;
+	uint32_t burstLength = 0; /*	Length of the burst errors, 0 for bit errors.	*/
+	/*	Detected errors corrected to the sent message, corrected to another message and left uncorrected, and the
+	 *	samples whose flips all cancelled out, for correction records, whose undetected errors are in collisions.
+	 *	The five outcomes add up to the samples.	*/
+	uint64_t nrCorrected = 0;
+	uint64_t nrMiscorrected = 0;
+	uint64_t nrUncorrectable = 0;
+	uint64_t nrErrorFree = 0;
+	/*	Shard of the process that wrote the record, of nrShards, set by the writer.	*/
+	uint32_t shard = 0;
+	uint32_t nrShards = 1;
+};
+
+/**
+ * Read the records of a CSV or JSON Lines results file written by ResultsWriter, the columns are matched by name
+ * and the missing ones keep their defaults. Returns false if the file can not be opened, throws
+ * std::invalid_argument if it is in another format.
+ */
+extern bool readResultRecords(const std::string &path, std::vector<ResultRecord> &records);
+
+/**
+ * Writes the result records as text, CSV or JSON Lines. Records are queued by the workers and
+ * written in batches by a single aggregator thread, so the workers never block on the output.
+ * The text format shows every record but the task records.
+ */
+class ResultsWriter {
+  public:
+	/**
+	 * z is the normal quantile of the confidence level of the reported intervals. Every record is written as part
+	 * of the shard, of nrShards.
+	 */
+	ResultsWriter(ResultFormat format, FILE *file, double z, uint32_t shard = 0, uint32_t nrShards = 1);
+	~ResultsWriter();
+
+	ResultsWriter(const ResultsWriter &) = delete;
+	ResultsWriter &operator=(const ResultsWriter &) = delete;
+
+	ResultFormat getFormat() const noexcept { return format; }
+
+	/**
+	 * File the records are written to, for output written between flushes.
+	 */
+	FILE *getFile() const noexcept { return file; }
+
+	void write(ResultRecord record);
+
+	/**
+	 * Block until every queued record has been written, for interleaving other output.
+	 */
+	void flush();
+
+  private:
+	void run();
+	void formatRecord(const ResultRecord &record, std::string &out);
+
+	const ResultFormat format;
+	FILE *const file;
+	const double z;
+	const uint32_t shard;
+	const uint32_t nrShards;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable pendingChanged;
+	std::vector<ResultRecord> pending;
+	uint64_t nrQueued = 0;
+	uint64_t nrWritten = 0;
+	bool stopping = false;
+
+	/*	Only accessed by the aggregator thread.	*/
+	bool progressPending = false;
+};
@@ -0,0 +1,488 @@
+#include "CRCSearch.h"
+#include "CRCCheckpoint.h"
+#include "CRCSweep.h"
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static uint64_t parsePolynomial(const std::string &text) {
+	try {
+		size_t parsed;
+		const uint64_t value = std::stoull(text, &parsed, 0);
+		if (parsed == text.size()) {
+			return value;
+		}
+	} catch (const std::exception &) {
+	}
+	throw std::invalid_argument("Invalid search polynomial '" + text + "'");
+}
+
+SearchSpec parseSearchSpec(const std::string &spec) {
+	SearchSpec search;
+	bool hasPolynomials = false;
+
+	size_t begin = 0;
+	while (begin <= spec.size()) {
+		size_t end = spec.find(',', begin);
+		if (end == std::string::npos) {
+			end = spec.size();
+		}
+		const std::string entry = spec.substr(begin, end - begin);
+		begin = end + 1;
+
+		const size_t assign = entry.find('=');
+		if (assign == std::string::npos) {
+			throw std::invalid_argument("Invalid search entry '" + entry + "', expected key=value");
+		}
+		const std::string key = entry.substr(0, assign);
+		const std::string value = entry.substr(assign + 1);
+
+		if (key == "width") {
+			const std::vector<double> values = parseSweepRange(key, value);
+			if (values.size() != 1 || values[0] < 3 || values[0] > 64 ||
+				values[0] != static_cast<unsigned int>(values[0])) {
+				throw std::invalid_argument("Search width must be a single integer within [3, 64]");
+			}
+			search.width = static_cast<unsigned int>(values[0]);
+		} else if (key == "size") {
+			for (const double size : parseSweepRange(key, value)) {
+				if (size < 1 || size > searchMaxMessageSize || size != static_cast<uint32_t>(size)) {
+					throw std::invalid_argument("Search message sizes must be integers within [1, " +
+												std::to_string(searchMaxMessageSize) + "]");
+				}
+				search.messageSizes.push_back(static_cast<uint32_t>(size));
+			}
+		} else if (key == "top") {
+			const std::vector<double> values = parseSweepRange(key, value);
+			if (values.size() != 1 || values[0] < 1 || !isUInt32Value(values[0])) {
+				throw std::invalid_argument("Search top must be a single positive integer");
+			}
+			search.nrTop = static_cast<unsigned int>(values[0]);
+		} else if (key == "poly") {
+			const size_t separator = value.find("..");
+			search.firstPolynomial = parsePolynomial(value.substr(0, separator));
+			search.lastPolynomial =
+				separator == std::string::npos ? search.firstPolynomial : parsePolynomial(value.substr(separator + 2));
+			hasPolynomials = true;
+		} else if (key == "parity") {
+			search.parity = value == "1";
+			if (!search.parity && value != "0") {
+				throw std::invalid_argument("Search parity must be 0 or 1");
+			}
+		} else {
+			throw std::invalid_argument("Unknown search key '" + key + "', expected width, size, top, poly or parity");
+		}
+	}
+
+	if (search.width == 0) {
+		throw std::invalid_argument("Search requires a width");
+	}
+	const uint64_t widthMask =
+		search.width >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << search.width) - 1;
+	if (!hasPolynomials) {
+		search.firstPolynomial = 1;
+		search.lastPolynomial = widthMask;
+	}
+	/*	Only the polynomials with the x^0 term, the others are x times a polynomial of lower degree.	*/
+	search.firstPolynomial |= 1;
+	if (search.lastPolynomial % 2 == 0) {
+		search.lastPolynomial--;
+	}
+	if (search.firstPolynomial > search.lastPolynomial || search.lastPolynomial > widthMask) {
+		throw std::invalid_argument("Search polynomials must be an ascending range within the width");
+	}
+
+	std::sort(search.messageSizes.begin(), search.messageSizes.end(), std::greater<uint32_t>());
+	search.messageSizes.erase(std::unique(search.messageSizes.begin(), search.messageSizes.end()),
+							  search.messageSizes.end());
+	return search;
+}
+
+std::string formatSearchSpec(const SearchSpec &spec) {
+	std::ostringstream out;
+	out << "width=" << spec.width << ",size=";
+	for (size_t i = 0; i < spec.messageSizes.size(); i++) {
+		out << (i > 0 ? ":" : "") << spec.messageSizes[i];
+	}
+	out << ",top=" << spec.nrTop << ",poly=0x" << std::hex << spec.firstPolynomial << "..0x" << spec.lastPolynomial
+		<< std::dec << ",parity=" << spec.parity;
+	return out.str();
+}
+
+/**
+ * Compare the components of two scores from the largest message size, up to nrSizes of them.
+ * Negative if a ranks before b, positive if after, 0 if equal.
+ */
+static int compareScores(const PolynomialScore &a, const PolynomialScore &b, size_t nrSizes) noexcept {
+	for (size_t i = 0; i < nrSizes; i++) {
+		if (a.hammingDistances[i] != b.hammingDistances[i]) {
+			return a.hammingDistances[i] > b.hammingDistances[i] ? -1 : 1;
+		}
+		if (a.nrUndetected[i] != b.nrUndetected[i]) {
+			return a.nrUndetected[i] < b.nrUndetected[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+bool isBetterScore(const PolynomialScore &a, const PolynomialScore &b) noexcept {
+	const int order = compareScores(a, b, a.hammingDistances.size());
+	return order != 0 ? order < 0 : a.polynomial < b.polynomial;
+}
+
+/**
+ * Open addressing map from a syndrome to a bit position. The syndromes of the single bits are distinct once no
+ * error of weight 2 goes undetected, and those of the pairs of bits once none of weight 4 or less does.
+ */
+class SyndromePositions {
+  public:
+	/**
+	 * Empty the map, sized for nrEntries syndromes.
+	 */
+	void reset(size_t nrEntries) {
+		nrBits = getNrSlotBits(nrEntries);
+		keys.assign(static_cast<size_t>(1) << nrBits, 0);
+		positions.resize(keys.size());
+	}
+
+	/**
+	 * Bytes of the slots of a map sized for nrEntries syndromes, between 24 and 48 bytes per entry.
+	 */
+	static size_t getMemorySize(size_t nrEntries) noexcept {
+		return (static_cast<size_t>(1) << getNrSlotBits(nrEntries)) * (sizeof(uint64_t) + sizeof(uint32_t));
+	}
+
+	void insert(uint64_t syndrome, uint32_t position) noexcept {
+		size_t slot = hash(syndrome);
+		while (keys[slot] != 0) {
+			slot = (slot + 1) & (keys.size() - 1);
+		}
+		keys[slot] = syndrome;
+		positions[slot] = position;
+	}
+
+	void assign(const std::vector<uint64_t> &columns) {
+		reset(columns.size());
+		for (size_t i = 0; i < columns.size(); i++) {
+			insert(columns[i], static_cast<uint32_t>(i));
+		}
+	}
+
+	/**
+	 * Position of the bit with the syndrome, or -1.
+	 */
+	int64_t find(uint64_t syndrome) const noexcept {
+		if (syndrome == 0) {
+			return -1;
+		}
+		for (size_t slot = hash(syndrome); keys[slot] != 0; slot = (slot + 1) & (keys.size() - 1)) {
+			if (keys[slot] == syndrome) {
+				return positions[slot];
+			}
+		}
+		return -1;
+	}
+
+  private:
+	/*	At most half of the slots are used, the number of slots is a power of two.	*/
+	static unsigned int getNrSlotBits(size_t nrEntries) noexcept {
+		unsigned int nrBits = 1;
+		while ((static_cast<size_t>(1) << nrBits) < 2 * nrEntries) {
+			nrBits++;
+		}
+		return nrBits;
+	}
+
+	size_t hash(uint64_t syndrome) const noexcept {
+		return static_cast<size_t>((syndrome * 0x9E3779B97F4A7C15ull) >> (64 - nrBits));
+	}
+
+	unsigned int nrBits = 1;
+	std::vector<uint64_t> keys;
+	std::vector<uint32_t> positions;
+};
+
+/**
+ * Reservation of the memory of a pair table. The tables in use by all the threads are held within
+ * searchPairTableBudget bytes, a reservation waits for the others to be released until its own fits.
+ */
+class PairTableReservation {
+  public:
+	explicit PairTableReservation(size_t size) : size(size) {
+		std::unique_lock<std::mutex> lock(mutex);
+		released.wait(lock, [size] { return inUse + size <= searchPairTableBudget; });
+		inUse += size;
+	}
+
+	~PairTableReservation() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			inUse -= size;
+		}
+		released.notify_all();
+	}
+
+	PairTableReservation(const PairTableReservation &) = delete;
+	PairTableReservation &operator=(const PairTableReservation &) = delete;
+
+  private:
+	static std::mutex mutex;
+	static std::condition_variable released;
+	static size_t inUse;
+
+	const size_t size;
+};
+
+std::mutex PairTableReservation::mutex;
+std::condition_variable PairTableReservation::released;
+size_t PairTableReservation::inUse = 0;
+
+/**
+ * Hamming distance of the shortened cyclic code of nrBits bits, up to searchMaxDistance, and the number of
+ * undetected patterns of that weight. The polynomial has the x^0 term, so every undetected pattern is a shift
+ * of one that starts at bit 0, only those are enumerated and weighted by their number of shifts.
+ * Stops and returns false as soon as the code is worse than a distance of boundDistance with boundUndetected
+ * undetected patterns. The weights 5 and 6 are only evaluated if the map of the pairs of bits fits in
+ * searchPairTableBudget bytes, the distance is otherwise reported as at least 5.
+ */
+static bool computeDistance(uint64_t polynomial, unsigned int width, size_t nrBits, uint8_t boundDistance,
+							uint64_t boundUndetected, std::vector<uint64_t> &columns, SyndromePositions &positions,
+							uint8_t &distance, uint64_t &nrUndetected) {
+	const uint64_t topBit = static_cast<uint64_t>(1) << (width - 1);
+	const uint64_t mask = width >= 64 ? ~static_cast<uint64_t>(0) : (topBit << 1) - 1;
+
+	/*	Syndrome of bit j is x^j mod P.	*/
+	columns.resize(nrBits);
+	uint64_t syndrome = 1;
+	for (size_t j = 0; j < nrBits; j++) {
+		columns[j] = syndrome;
+		syndrome = (syndrome & topBit) ? ((syndrome << 1) & mask) ^ polynomial : (syndrome << 1) & mask;
+	}
+
+	/*	Undetected patterns of a weight below the bound, or more of them than the bound.	*/
+	const auto isWorse = [&](uint8_t weight) {
+		return nrUndetected > 0 &&
+			   (weight < boundDistance || (weight == boundDistance && nrUndetected > boundUndetected));
+	};
+
+	/*	Weight 2, x^a = 1.	*/
+	nrUndetected = 0;
+	for (size_t a = 1; a < nrBits; a++) {
+		if (columns[a] == 1) {
+			nrUndetected += nrBits - a;
+		}
+	}
+	if (nrUndetected > 0) {
+		distance = 2;
+		return !isWorse(2);
+	}
+
+	/*	Weight 3, 1 + x^a + x^b with a < b.	*/
+	positions.assign(columns);
+	for (size_t a = 1; a < nrBits; a++) {
+		const int64_t b = positions.find(columns[a] ^ 1);
+		if (b > static_cast<int64_t>(a)) {
+			nrUndetected += nrBits - b;
+			if (isWorse(3)) {
+				return false;
+			}
+		}
+	}
+	if (nrUndetected > 0) {
+		distance = 3;
+		return true;
+	}
+
+	/*	Weight 4, 1 + x^a + x^b + x^c with a < b < c.	*/
+	for (size_t a = 1; a < nrBits; a++) {
+		const uint64_t partial = columns[a] ^ 1;
+		for (size_t b = a + 1; b < nrBits; b++) {
+			const int64_t c = positions.find(partial ^ columns[b]);
+			if (c > static_cast<int64_t>(b)) {
+				nrUndetected += nrBits - c;
+			}
+		}
+		if (isWorse(4)) {
+			return false;
+		}
+	}
+	if (nrUndetected > 0) {
+		distance = 4;
+		return true;
+	}
+
+	/*	Weight 5 and 6 meet in the middle on the syndromes of the pairs x^c + x^d, mapped to d. Every pattern of a
+	 *	lower weight is detected from here on, so a pair matching the other bits of a pattern shares none of them
+	 *	and is the only one with its syndrome, c is then the bit with the syndrome of the pair without d.	*/
+	const size_t nrPairs = nrBits * (nrBits - 1) / 2;
+	const size_t pairTableSize = SyndromePositions::getMemorySize(nrPairs);
+	if (pairTableSize > searchPairTableBudget) {
+		distance = 5;
+		return true;
+	}
+	/*	Freed before the reservation ends, on every return.	*/
+	const PairTableReservation reservation(pairTableSize);
+	SyndromePositions pairPositions;
+	pairPositions.reset(nrPairs);
+	for (size_t c = 0; c < nrBits; c++) {
+		for (size_t d = c + 1; d < nrBits; d++) {
+			pairPositions.insert(columns[c] ^ columns[d], static_cast<uint32_t>(d));
+		}
+	}
+
+	/*	Weight 5, 1 + x^a + x^b + x^c + x^d with a < b < c < d.	*/
+	for (size_t a = 1; a < nrBits; a++) {
+		for (size_t b = a + 1; b < nrBits; b++) {
+			const uint64_t partial = columns[a] ^ columns[b] ^ 1;
+			const int64_t d = pairPositions.find(partial);
+			if (d >= 0 && positions.find(partial ^ columns[d]) > static_cast<int64_t>(b)) {
+				nrUndetected += nrBits - d;
+			}
+		}
+		if (isWorse(5)) {
+			return false;
+		}
+	}
+	if (nrUndetected > 0) {
+		distance = 5;
+		return true;
+	}
+
+	/*	Weight 6, 1 + x^a + x^b + x^c + x^d + x^e with a < b < c < d < e.	*/
+	for (size_t a = 1; a < nrBits; a++) {
+		for (size_t b = a + 1; b < nrBits; b++) {
+			const uint64_t pair = columns[a] ^ columns[b] ^ 1;
+			for (size_t c = b + 1; c < nrBits; c++) {
+				const uint64_t partial = pair ^ columns[c];
+				const int64_t e = pairPositions.find(partial);
+				if (e >= 0 && positions.find(partial ^ columns[e]) > static_cast<int64_t>(c)) {
+					nrUndetected += nrBits - e;
+				}
+			}
+		}
+		if (isWorse(6)) {
+			return false;
+		}
+	}
+	distance = nrUndetected > 0 ? 6 : searchMaxDistance;
+	return true;
+}
+
+bool evaluatePolynomial(const SearchSpec &spec, uint64_t polynomial, const PolynomialScore *bound,
+						PolynomialScore &score) {
+	thread_local std::vector<uint64_t> columns;
+	thread_local SyndromePositions positions;
+
+	score.polynomial = polynomial;
+	score.hammingDistances.assign(spec.messageSizes.size(), 0);
+	score.nrUndetected.assign(spec.messageSizes.size(), 0);
+
+	for (size_t i = 0; i < spec.messageSizes.size(); i++) {
+		/*	While tied with the bound, the size can not do worse than the bound at it.	*/
+		const uint8_t boundDistance = bound != nullptr ? bound->hammingDistances[i] : 0;
+		const uint64_t boundUndetected = bound != nullptr ? bound->nrUndetected[i] : 0;
+		if (!computeDistance(polynomial, spec.width, spec.messageSizes[i] * 8 + spec.width, boundDistance,
+							 boundUndetected, columns, positions, score.hammingDistances[i], score.nrUndetected[i])) {
+			return false;
+		}
+
+		if (bound != nullptr) {
+			const int order = compareScores(score, *bound, i + 1);
+			if (order > 0 || (order == 0 && i + 1 == spec.messageSizes.size() && polynomial > bound->polynomial)) {
+				return false;
+			}
+			/*	Already ahead of the bound, the remaining sizes only order it.	*/
+			if (order < 0) {
+				bound = nullptr;
+			}
+		}
+	}
+	return true;
+}
+
+void SearchTopPolynomials::insert(const PolynomialScore &score) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const PolynomialScore &kept : scores) {
+		if (kept.polynomial == score.polynomial) {
+			return;
+		}
+	}
+	scores.insert(std::upper_bound(scores.begin(), scores.end(), score, isBetterScore), score);
+	if (scores.size() > nrTop) {
+		scores.pop_back();
+	}
+}
+
+bool SearchTopPolynomials::getBound(PolynomialScore &bound) {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (scores.size() < nrTop) {
+		return false;
+	}
+	bound = scores.back();
+	return true;
+}
+
+std::vector<PolynomialScore> SearchTopPolynomials::getScores() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return scores;
+}
+
+bool writeSearchCheckpoint(const std::string &path, const std::string &spec, uint64_t nextCandidate,
+						   const std::vector<PolynomialScore> &scores) {
+	const std::string temporaryPath = path + ".tmp";
+	FILE *file = fopen(temporaryPath.c_str(), "w");
+	if (file == nullptr) {
+		return false;
+	}
+
+	fprintf(file, "crc-search %s\nnext %" PRIu64 "\n", spec.c_str(), nextCandidate);
+	for (const PolynomialScore &score : scores) {
+		fprintf(file, "0x%" PRIx64, score.polynomial);
+		for (size_t i = 0; i < score.hammingDistances.size(); i++) {
+			fprintf(file, " %u:%" PRIu64, score.hammingDistances[i], score.nrUndetected[i]);
+		}
+		fputc('\n', file);
+	}
+
+	return replaceCheckpointFile(file, true, temporaryPath, path);
+}
+
+bool readSearchCheckpoint(const std::string &path, const std::string &spec, uint64_t &nextCandidate,
+						  std::vector<PolynomialScore> &scores) {
+	std::ifstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	std::string line;
+	if (!std::getline(file, line) || line != "crc-search " + spec) {
+		throw std::invalid_argument("Checkpoint " + path + " belongs to another search");
+	}
+	if (!std::getline(file, line) || std::sscanf(line.c_str(), "next %" SCNu64, &nextCandidate) != 1) {
+		throw std::invalid_argument("Malformed checkpoint " + path);
+	}
+
+	scores.clear();
+	while (std::getline(file, line)) {
+		std::istringstream entry(line);
+		std::string polynomial, component;
+		PolynomialScore score;
+		entry >> polynomial;
+		score.polynomial = parsePolynomial(polynomial);
+		while (entry >> component) {
+			unsigned int distance;
+			uint64_t nrUndetected;
+			if (std::sscanf(component.c_str(), "%u:%" SCNu64, &distance, &nrUndetected) != 2) {
+				throw std::invalid_argument("Malformed checkpoint " + path);
+			}
+			score.hammingDistances.push_back(static_cast<uint8_t>(distance));
+			score.nrUndetected.push_back(nrUndetected);
+		}
+		scores.push_back(score);
+	}
+	return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Hamming distances are evaluated up to the weight below this one, a larger distance is reported as at least
+ * it. Weight 5 and 6 hold the syndromes of every pair of bits of the message and CRC, 24 to 48 bytes per pair.
+ * A message size whose pair table exceeds searchPairTableBudget bytes is reported as at least 5, whatever the
+ * number of threads, and the tables in use at once by all the threads are held within the same budget.
+ */
+static constexpr unsigned int searchMaxDistance = 7;
+static constexpr uint32_t searchMaxMessageSize = 1024;
+static constexpr size_t searchPairTableBudget = static_cast<size_t>(1) << 30;
+
+/**
+ * Polynomials of a single width to scan, the odd polynomials within [firstPolynomial, lastPolynomial]
+ * in the normal form without the x^width term.
+ */
+struct SearchSpec {
+	unsigned int width = 0;
+	std::vector<uint32_t> messageSizes; /*	In bytes, sorted from the largest.	*/
+	unsigned int nrTop = 10;
+	uint64_t firstPolynomial = 0;
+	uint64_t lastPolynomial = 0;
+	bool parity = false; /*	Only the polynomials divisible by x + 1, detecting every odd number of bit errors.	*/
+
+	uint64_t getNrCandidates() const noexcept { return (lastPolynomial - firstPolynomial) / 2 + 1; }
+	uint64_t getCandidate(uint64_t index) const noexcept { return firstPolynomial + 2 * index; }
+
+	/**
+	 * Whether the candidate passes the filters, x + 1 divides it if it has an even number of terms.
+	 */
+	bool isSelected(uint64_t polynomial) const noexcept {
+		unsigned int nrTerms = 1;
+		for (; polynomial != 0; polynomial &= polynomial - 1) {
+			nrTerms++;
+		}
+		return !parity || nrTerms % 2 == 0;
+	}
+};
+
+/**
+ * Parse a search specification, comma separated key=value entries. width is required, size takes a
+ * range as the sweep does, top the number of polynomials to keep, poly a first..last range of
+ * polynomials, in hex with 0x, and parity=1 restricts the search to the polynomials divisible by x + 1.
+ * Message sizes that are not specified are left empty.
+ * Throws std::invalid_argument on a malformed specification.
+ */
+extern SearchSpec parseSearchSpec(const std::string &spec);
+
+/**
+ * Canonical form of a complete specification, identifying the search in its checkpoints.
+ */
+extern std::string formatSearchSpec(const SearchSpec &spec);
+
+/**
+ * Hamming distance of a polynomial at every message size of the search, and the number of undetected
+ * error patterns of that weight, 0 when the distance is only known to be at least the one given, searchMaxDistance
+ * or 5 past the budget of the pair table. The errors span the message and the CRC bits.
+ */
+struct PolynomialScore {
+	uint64_t polynomial;
+	std::vector<uint8_t> hammingDistances;
+	std::vector<uint64_t> nrUndetected;
+};
+
+/**
+ * Ranking of the scores, the larger Hamming distance and then the fewer undetected patterns at the
+ * largest message size first, then at the next sizes. Ties go to the smaller polynomial.
+ */
+extern bool isBetterScore(const PolynomialScore &a, const PolynomialScore &b) noexcept;
+
+/**
+ * Evaluate a polynomial at every message size of the search, from the largest. Stops as soon as the
+ * polynomial can no longer rank before the bound, if any, and returns false in that case. May wait for the pair
+ * tables of the other threads to be freed.
+ */
+extern bool evaluatePolynomial(const SearchSpec &spec, uint64_t polynomial, const PolynomialScore *bound,
+							   PolynomialScore &score);
+
+/**
+ * Best polynomials found so far, shared by the search tasks.
+ */
+class SearchTopPolynomials {
+  public:
+	explicit SearchTopPolynomials(unsigned int nrTop) : nrTop(nrTop) {}
+
+	/**
+	 * Insert the score, ignored if the polynomial is already present.
+	 */
+	void insert(const PolynomialScore &score);
+
+	/**
+	 * Copy of the worst kept score once the list is full, for pruning. Returns false while not full.
+	 */
+	bool getBound(PolynomialScore &bound);
+
+	/**
+	 * Copy of the kept scores, from the best.
+	 */
+	std::vector<PolynomialScore> getScores();
+
+  private:
+	const unsigned int nrTop;
+	std::mutex mutex;
+	std::vector<PolynomialScore> scores; /*	Sorted from the best.	*/
+};
+
+/**
+ * Write the progress of a search, the candidates before nextCandidate have all been evaluated. The file
+ * is replaced atomically and synced to the disk, a crash keeps either the previous or the new checkpoint.
+ */
+extern bool writeSearchCheckpoint(const std::string &path, const std::string &spec, uint64_t nextCandidate,
+								  const std::vector<PolynomialScore> &scores);
+
+/**
+ * Read a checkpoint written for the same search specification. Returns false if the file does not exist,
+ * throws std::invalid_argument if it belongs to another search or is malformed.
+ */
+extern bool readSearchCheckpoint(const std::string &path, const std::string &spec, uint64_t &nextCandidate,
+								 std::vector<PolynomialScore> &scores);
@@ -0,0 +1,46 @@
+#include "CRCStatistics.h"
+#include <algorithm>
+#include <cmath>
+
+double computeNormalQuantile(double confidence) {
+	/*	Bisect erfc(z / sqrt(2)) = 1 - confidence, monotonically decreasing in z.	*/
+	const double alpha = 1 - confidence;
+	double low = 0, high = 40;
+	for (unsigned int i = 0; i < 100; i++) {
+		const double z = (low + high) / 2;
+		if (std::erfc(z / std::sqrt(2.0)) > alpha) {
+			low = z;
+		} else {
+			high = z;
+		}
+	}
+	return (low + high) / 2;
+}
+
+ConfidenceInterval computeConfidenceInterval(uint64_t nrSuccess, uint64_t nrTrials, double z) {
+	if (nrTrials == 0) {
+		return {0, 1};
+	}
+	const double n = static_cast<double>(nrTrials);
+
+	if (nrSuccess == 0) {
+		const double alpha = std::erfc(z / std::sqrt(2.0));
+		return {0, 1 - std::pow(alpha / 2, 1 / n)};
+	}
+
+	const double p = static_cast<double>(nrSuccess) / n;
+	const double z2 = z * z;
+	const double denominator = 1 + z2 / n;
+	const double center = (p + z2 / (2 * n)) / denominator;
+	const double halfWidth = z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denominator;
+	return {std::max(0.0, center - halfWidth), std::min(1.0, center + halfWidth)};
+}
+
+bool isIntervalConverged(uint64_t nrSuccess, uint64_t nrTrials, double z, double targetRelativeError) {
+	if (nrSuccess == 0) {
+		return false;
+	}
+	const double p = static_cast<double>(nrSuccess) / static_cast<double>(nrTrials);
+	const ConfidenceInterval interval = computeConfidenceInterval(nrSuccess, nrTrials, z);
+	return std::max(p - interval.lower, interval.upper - p) <= targetRelativeError * p;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Confidence interval of a binomial proportion.
+ */
+struct ConfidenceInterval {
+	double lower;
+	double upper;
+};
+
+/**
+ * Two-sided standard normal quantile of the confidence level, e.g. 1.96 for 0.95.
+ */
+extern double computeNormalQuantile(double confidence);
+
+/**
+ * Wilson score interval of nrSuccess out of nrTrials, z is the normal quantile of the confidence level.
+ * Without any success the exact Clopper-Pearson upper bound is used instead, 1 - (alpha / 2)^(1 / n).
+ */
+extern ConfidenceInterval computeConfidenceInterval(uint64_t nrSuccess, uint64_t nrTrials, double z);
+
+/**
+ * Check if the confidence interval is within the relative error of the observed proportion.
+ * Never true without a success, the proportion could still be zero.
+ */
+extern bool isIntervalConverged(uint64_t nrSuccess, uint64_t nrTrials, double z, double targetRelativeError);
@@ -0,0 +1,94 @@
+#include "CRCSweep.h"
+#include <stdexcept>
+
+std::vector<double> parseSweepRange(const std::string &key, const std::string &range) {
+	size_t parsed;
+	const auto parseNumber = [&](const std::string &text) {
+		try {
+			const double value = std::stod(text, &parsed);
+			if (parsed == text.size()) {
+				return value;
+			}
+		} catch (const std::exception &) {
+		}
+		throw std::invalid_argument("Invalid sweep value '" + text + "' for " + key);
+	};
+
+	const size_t separator = range.find("..");
+	if (separator == std::string::npos) {
+		return {parseNumber(range)};
+	}
+
+	const size_t stepSeparator = range.find(':', separator);
+	const double first = parseNumber(range.substr(0, separator));
+	const double last = parseNumber(range.substr(separator + 2, stepSeparator == std::string::npos
+																	? std::string::npos
+																	: stepSeparator - separator - 2));
+	bool multiply = false;
+	double step = 1;
+	if (stepSeparator != std::string::npos) {
+		const std::string stepStr = range.substr(stepSeparator + 1);
+		if (stepStr.size() < 2 || (stepStr[0] != 'x' && stepStr[0] != '+')) {
+			throw std::invalid_argument("Invalid sweep step '" + stepStr + "' for " + key);
+		}
+		multiply = stepStr[0] == 'x';
+		step = parseNumber(stepStr.substr(1));
+	}
+	if (first > last || (multiply ? (step <= 1 || first <= 0) : step <= 0)) {
+		throw std::invalid_argument("Invalid sweep range '" + range + "' for " + key);
+	}
+
+	std::vector<double> values;
+	/*	Tolerate the rounding of fractional steps on the last value.	*/
+	for (double value = first; value <= last * (1 + 1e-9); value = multiply ? value * step : value + step) {
+		values.push_back(value);
+	}
+	return values;
+}
+
+SweepSpec parseSweepSpec(const std::string &spec) {
+	SweepSpec sweep;
+
+	size_t begin = 0;
+	while (begin <= spec.size()) {
+		size_t end = spec.find(',', begin);
+		if (end == std::string::npos) {
+			end = spec.size();
+		}
+		const std::string entry = spec.substr(begin, end - begin);
+		begin = end + 1;
+
+		const size_t assign = entry.find('=');
+		if (assign == std::string::npos) {
+			throw std::invalid_argument("Invalid sweep entry '" + entry + "', expected key=range");
+		}
+		const std::string key = entry.substr(0, assign);
+		const std::vector<double> values = parseSweepRange(key, entry.substr(assign + 1));
+
+		if (key == "b") {
+			for (const double value : values) {
+				if (!isUInt32Value(value) || value < 1) {
+					throw std::invalid_argument("Number of bit errors must be positive integers");
+				}
+				sweep.nrBitErrors.push_back(static_cast<uint32_t>(value));
+			}
+		} else if (key == "size") {
+			for (const double value : values) {
+				if (!isUInt32Value(value) || value < 1) {
+					throw std::invalid_argument("Message sizes must be positive integers");
+				}
+				sweep.messageSizes.push_back(static_cast<uint32_t>(value));
+			}
+		} else if (key == "P") {
+			for (const double value : values) {
+				if (value <= 0 || value > 1) {
+					throw std::invalid_argument("Error probabilities must be within (0, 1]");
+				}
+				sweep.probabilities.push_back(static_cast<float>(value));
+			}
+		} else {
+			throw std::invalid_argument("Unknown sweep key '" + key + "', expected b, size or P");
+		}
+	}
+	return sweep;
+}
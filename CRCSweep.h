@@ -0,0 +1,37 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Grid of sampling parameters, every combination of the values is a cell of the sweep.
+ */
+struct SweepSpec {
+	std::vector<uint32_t> nrBitErrors;
+	std::vector<uint32_t> messageSizes; /*	In bytes.	*/
+	std::vector<float> probabilities;
+};
+
+/**
+ * Expand a range, a single value, first..last with a step of 1, first..last:xN multiplying by N or
+ * first..last:+N adding N. key names the range in the error messages.
+ * Throws std::invalid_argument on a malformed range.
+ */
+extern std::vector<double> parseSweepRange(const std::string &key, const std::string &range);
+
+/**
+ * Whether a parsed value is an integer that fits in 32 bits, checked before any conversion, which is undefined
+ * out of range. NaN is not.
+ */
+static inline bool isUInt32Value(double value) noexcept {
+	return value >= 0 && value <= static_cast<double>(UINT32_MAX) && value == std::floor(value);
+}
+
+/**
+ * Parse a sweep specification, comma separated key=range entries with the keys b, size and P.
+ * A range is a single value, first..last with a step of 1, first..last:xN multiplying by N
+ * or first..last:+N adding N. Keys that are not specified are left empty.
+ * Throws std::invalid_argument on a malformed specification.
+ */
+extern SweepSpec parseSweepSpec(const std::string &spec);
@@ -0,0 +1,144 @@
+#pragma once
+#include "CRCCombine.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Create the per-bit syndrome table for messages of nrBytes. The CRC is affine over GF(2),
+ * CRC(msg ^ e) = CRC(msg) ^ CRC0(e), where CRC0(e) is the XOR of the syndromes of every bit set in e.
+ */
+template <typename Kernel> std::vector<uint64_t> createSyndromeTable(size_t nrBytes) {
+	std::vector<uint64_t> syndromes(nrBytes * 8);
+	Kernel::computeSyndromes(nrBytes, syndromes.data());
+	return syndromes;
+}
+
+/**
+ * Compute the CRC difference caused by flipping each of the bit indices.
+ */
+static inline uint64_t computeErrorSyndrome(const std::vector<uint64_t> &syndromes, const uint32_t *bitIndices,
+											unsigned int nrBits) noexcept {
+	uint64_t syndrome = 0;
+	for (unsigned int i = 0; i < nrBits; i++) {
+		syndrome ^= syndromes[bitIndices[i]];
+	}
+	return syndrome;
+}
+
+/**
+ * Check if the flips cancel each other out, that is if every bit index was flipped an even
+ * number of times. The bit indices are sorted in place.
+ */
+static inline bool isErrorPatternEmpty(uint32_t *bitIndices, unsigned int nrBits) noexcept {
+	std::sort(bitIndices, bitIndices + nrBits);
+	for (unsigned int i = 0; i < nrBits; i += 2) {
+		if (i + 1 >= nrBits || bitIndices[i] != bitIndices[i + 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Per-bit syndromes of messages too large for a table, computed for the flipped bits only. A bit followed by f
+ * bytes has the syndrome of the same bit in the tail of the message, shifted by the 8q bytes in between. The
+ * shift by x^(64q) mod P is the product of the shifts by 8 * 2^k bytes for the bits k set in q, created once by
+ * squaring and applied with a lookup per byte of the syndrome. The tail is 8 to 15 bytes long with the length of
+ * the message modulo 8, so that the XOR checksums, whose shift by 8 bytes is the identity, see the same word
+ * positions. Takes O(width log n) memory and O(width log n) per flipped bit instead of a table of n bits.
+ */
+class SparseSyndromes {
+  public:
+	SparseSyndromes() = default;
+
+	template <typename Kernel> static SparseSyndromes create(uint64_t nrBytes) {
+		SparseSyndromes sparse;
+		sparse.nrBytes = nrBytes;
+		sparse.nrTailBytes = nrBytes < 16 ? nrBytes : 8 + nrBytes % 8;
+		sparse.tail = createSyndromeTable<Kernel>(sparse.nrTailBytes);
+		sparse.nrShiftBytes = (Kernel::width + 7) / 8;
+
+		CRCShift shift(CRCShift::createByteShift<Kernel>(), 8);
+		for (uint64_t nrWords = (nrBytes - sparse.nrTailBytes) / 8; nrWords > 0; nrWords >>= 1) {
+			ShiftTable &table = sparse.wordShifts.emplace_back();
+			for (unsigned int i = 0; i < sparse.nrShiftBytes; i++) {
+				for (unsigned int b = 0; b < 256; b++) {
+					table[i][b] = shift.apply(static_cast<uint64_t>(b) << (i * 8));
+				}
+			}
+			shift = shift.compose(shift);
+		}
+		return sparse;
+	}
+
+	uint64_t getSyndrome(uint64_t bitIndex) const noexcept {
+		const uint64_t nrFollowing = nrBytes - 1 - bitIndex / 8;
+		const unsigned int bit = bitIndex % 8;
+		if (nrFollowing < nrTailBytes) {
+			return tail[(nrTailBytes - 1 - nrFollowing) * 8 + bit];
+		}
+
+		/*	Fewest words that bring the bit into the tail.	*/
+		uint64_t nrWords = (nrFollowing - nrTailBytes + 8) / 8;
+		uint64_t syndrome = tail[(nrTailBytes - 1 - (nrFollowing - nrWords * 8)) * 8 + bit];
+		for (size_t k = 0; nrWords > 0; k++, nrWords >>= 1) {
+			if (nrWords & 1) {
+				uint64_t shifted = 0;
+				for (unsigned int i = 0; i < nrShiftBytes; i++) {
+					shifted ^= wordShifts[k][i][(syndrome >> (i * 8)) & 0xFF];
+				}
+				syndrome = shifted;
+			}
+		}
+		return syndrome;
+	}
+
+	uint64_t computeErrorSyndrome(const uint32_t *bitIndices, unsigned int nrBits) const noexcept {
+		uint64_t syndrome = 0;
+		for (unsigned int i = 0; i < nrBits; i++) {
+			syndrome ^= getSyndrome(bitIndices[i]);
+		}
+		return syndrome;
+	}
+
+  private:
+	using ShiftTable = std::array<std::array<uint64_t, 256>, 8>;
+
+	uint64_t nrBytes = 0;
+	uint64_t nrTailBytes = 0;
+	unsigned int nrShiftBytes = 0;
+	std::vector<uint64_t> tail;
+	std::vector<ShiftTable> wordShifts; /*	Shift by 8 * 2^k bytes at k, a table per byte of the syndrome.	*/
+};
+
+/**
+ * Syndromes of the errors of the sampled messages, from the per-bit table or, for messages whose table would
+ * not fit comfortably in memory, computed sparsely. Empty when the error messages are rehashed.
+ */
+class ErrorSyndromes {
+  public:
+	ErrorSyndromes() = default;
+
+	explicit ErrorSyndromes(std::vector<uint64_t> table) noexcept : table(std::move(table)) {}
+
+	explicit ErrorSyndromes(SparseSyndromes sparse) noexcept : sparse(std::move(sparse)), isSparse(true) {}
+
+	bool isSparseSyndromes() const noexcept { return isSparse; }
+
+	uint64_t computeErrorSyndrome(const uint32_t *bitIndices, unsigned int nrBits) const noexcept {
+		return isSparse ? sparse.computeErrorSyndrome(bitIndices, nrBits)
+						: ::computeErrorSyndrome(table, bitIndices, nrBits);
+	}
+
+  private:
+	std::vector<uint64_t> table;
+	SparseSyndromes sparse;
+	bool isSparse = false;
+};
+
+/*	Largest per-bit syndrome table of a sampled message, in bytes, larger messages use the sparse syndromes.	*/
+static constexpr uint64_t maxSampleSyndromeTableSize = 64 * 1024 * 1024;
@@ -0,0 +1,99 @@
+#include "RandGenerator.h"
+#include "CRCHardware.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RAND_GENERATOR_X86
+#include <immintrin.h>
+#endif
+
+static inline uint32_t pcgOutput(uint64_t state) noexcept {
+	const uint32_t xorshifted = static_cast<uint32_t>(((state >> 18u) ^ state) >> 27u);
+	const uint32_t rot = static_cast<uint32_t>(state >> 59u);
+	return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+void PCGBatchRandom::fill(uint32_t *data, size_t size) noexcept {
+	const size_t nrVectorWords = size - size % nrLanes;
+
+#if defined(RAND_GENERATOR_X86)
+	if (getCPUFeatures().avx2) {
+		fillAVX2(data, nrVectorWords);
+	} else
+#endif
+	{
+		fillScalar(data, nrVectorWords);
+	}
+
+	/*	The remaining words come from the first lanes of one more step.	*/
+	if (nrVectorWords < size) {
+		uint32_t words[nrLanes];
+		fillScalar(words, nrLanes);
+		for (size_t i = nrVectorWords; i < size; i++) {
+			data[i] = words[i - nrVectorWords];
+		}
+	}
+}
+
+void PCGBatchRandom::fillScalar(uint32_t *data, size_t size) noexcept {
+	for (size_t i = 0; i < size; i += nrLanes) {
+		for (unsigned int lane = 0; lane < nrLanes; lane++) {
+			const uint64_t oldState = state[lane];
+			state[lane] = oldState * pcgMultiplier + increment[lane];
+			data[i + lane] = pcgOutput(oldState);
+		}
+	}
+}
+
+#if defined(RAND_GENERATOR_X86)
+
+#define RAND_TARGET_AVX2 __attribute__((target("avx2")))
+
+/**
+ * Low 64 bits of a 64x64-bit multiplication per lane, from 32x32-bit products.
+ */
+RAND_TARGET_AVX2 static inline __m256i multiplyLow64(const __m256i &a, const __m256i &b) {
+	const __m256i low = _mm256_mul_epu32(a, b);
+	const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+										   _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+	return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+RAND_TARGET_AVX2 static inline __m256i outputAVX2(const __m256i &state) {
+	const __m256i xorshifted = _mm256_and_si256(
+		_mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(state, 18), state), 27), _mm256_set1_epi64x(0xFFFFFFFF));
+	const __m256i rot = _mm256_srli_epi64(state, 59);
+	const __m256i rotated =
+		_mm256_or_si256(_mm256_srlv_epi64(xorshifted, rot),
+						_mm256_sllv_epi64(xorshifted, _mm256_sub_epi64(_mm256_set1_epi64x(32), rot)));
+	return _mm256_and_si256(rotated, _mm256_set1_epi64x(0xFFFFFFFF));
+}
+
+RAND_TARGET_AVX2 void PCGBatchRandom::fillAVX2(uint32_t *data, size_t size) noexcept {
+	static_assert(nrLanes == 8, "AVX2 path steps two vectors of four lanes");
+
+	const __m256i multiplier = _mm256_set1_epi64x(static_cast<long long>(pcgMultiplier));
+	const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+	const __m256i increment0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&increment[0]));
+	const __m256i increment1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&increment[4]));
+	__m256i state0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&state[0]));
+	__m256i state1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(&state[4]));
+
+	for (size_t i = 0; i < size; i += nrLanes) {
+		/*	Gather the low 32 bits of the eight 64-bit lanes into one vector.	*/
+		const __m256i output0 = _mm256_permutevar8x32_epi32(outputAVX2(state0), pack);
+		const __m256i output1 = _mm256_permutevar8x32_epi32(outputAVX2(state1), pack);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&data[i]), _mm256_blend_epi32(output0, output1, 0xF0));
+
+		state0 = _mm256_add_epi64(multiplyLow64(state0, multiplier), increment0);
+		state1 = _mm256_add_epi64(multiplyLow64(state1, multiplier), increment1);
+	}
+
+	_mm256_store_si256(reinterpret_cast<__m256i *>(&state[0]), state0);
+	_mm256_store_si256(reinterpret_cast<__m256i *>(&state[4]), state1);
+}
+
+#else
+
+void PCGBatchRandom::fillAVX2(uint32_t *data, size_t size) noexcept { fillScalar(data, size); }
+
+#endif
@@ -1,47 +1,97 @@
 #pragma once
 #include "pcg_basic.h"
+#include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <random>
-#include <stdlib.h>
-#include <time.h>
 
-class RandGenerator {
-  public:
-	virtual uint32_t getRandom() noexcept = 0;
-	virtual float getRandomNormalized() noexcept = 0;
-};
+/**
+ * Expand a seed into well mixed state bits.
+ */
+static inline uint64_t splitMix64(uint64_t &state) noexcept {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
 
-class PGSRandom : public RandGenerator {
+static constexpr uint64_t pcgMultiplier = 6364136223846793005ull;
+
+/**
+ * Scalar PCG32 generator. Deterministic for a given seed and stream id, streams with different
+ * ids are independent sequences.
+ */
+class PCGRandom {
   public:
-	PGSRandom() {
-		srand(time(nullptr));
-		pcg32_srandom_r(&rng, rand(), rand());
+	PCGRandom(uint64_t seed, uint64_t streamId) noexcept {
+		uint64_t mix = seed;
+		pcg32_srandom_r(&rng, splitMix64(mix), streamId);
 	}
-	uint32_t getRandom() noexcept override { return pcg32_random_r(&rng); }
 
-	float getRandomNormalized() noexcept override {
-		return static_cast<float>(this->getRandom()) * (1.0 / static_cast<float>(std::numeric_limits<uint32_t>::max()));
+	uint32_t getRandom() noexcept { return pcg32_random_r(&rng); }
+
+	float getRandomNormalized() noexcept {
+		return static_cast<float>(this->getRandom()) * (1.0f / static_cast<float>(std::numeric_limits<uint32_t>::max()));
+	}
+
+	/**
+	 * Uniform double in (0, 1] with 53 random bits, from two draws. Never 0, so its logarithm is finite.
+	 */
+	double getRandomOpenUnit() noexcept {
+		const uint64_t high = this->getRandom();
+		const uint64_t bits = (high << 21) ^ (this->getRandom() >> 11);
+		return static_cast<double>(bits + 1) * (1.0 / 9007199254740992.0);
+	}
+
+	/**
+	 * Uniform integer in [0, range), Lemire's multiply-shift with rejection of the biased values.
+	 */
+	uint32_t getRandomRange(uint32_t range) noexcept {
+		uint64_t product = static_cast<uint64_t>(this->getRandom()) * range;
+		uint32_t low = static_cast<uint32_t>(product);
+		if (low < range) {
+			const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+			while (low < threshold) {
+				product = static_cast<uint64_t>(this->getRandom()) * range;
+				low = static_cast<uint32_t>(product);
+			}
+		}
+		return static_cast<uint32_t>(product >> 32);
 	}
 
   private:
 	pcg32_random_t rng;
 };
 
-class UniformRandom : public RandGenerator {
+/**
+ * PCG32 with nrLanes independent streams stepped together, for filling whole message buffers.
+ * Word i of a fill comes from lane i % nrLanes, the AVX2 and scalar paths produce the same sequence.
+ */
+class PCGBatchRandom {
   public:
-	UniformRandom() {
-		this->distribution = std::uniform_real_distribution<float>(0.0, 1.0);
-		std::random_device rd; // Will be used to obtain a seed for the random number engine
-		this->generator = std::mt19937(rd());
-	}
-	uint32_t getRandom() noexcept override {
-		return static_cast<uint32_t>(static_cast<float>(std::numeric_limits<uint32_t>::max()) *
-									 this->distribution(this->generator));
+	static constexpr unsigned int nrLanes = 8;
+
+	PCGBatchRandom(uint64_t seed, uint64_t streamId) noexcept {
+		/*	Skip the first expansion of the seed, used by PCGRandom, so the lanes start elsewhere in the sequence.	*/
+		uint64_t mix = seed;
+		splitMix64(mix);
+		const uint64_t initState = splitMix64(mix);
+		for (unsigned int lane = 0; lane < nrLanes; lane++) {
+			pcg32_random_t rng;
+			pcg32_srandom_r(&rng, initState, streamId * nrLanes + lane);
+			state[lane] = rng.state;
+			increment[lane] = rng.inc;
+		}
 	}
-	float getRandomNormalized() noexcept override { return this->distribution(this->generator); }
+
+	/**
+	 * Fill size words with random values.
+	 */
+	void fill(uint32_t *data, size_t size) noexcept;
 
   private:
-	std::uniform_real_distribution<float> distribution;
-	std::mt19937 generator;
-};
\ No newline at end of file
+	alignas(32) uint64_t state[nrLanes];
+	alignas(32) uint64_t increment[nrLanes];
+
+	void fillScalar(uint32_t *data, size_t size) noexcept;
+	void fillAVX2(uint32_t *data, size_t size) noexcept;
+};
@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Number of samples drawn from the random streams of a single block. Blocks are the unit of
+ * reproducibility, the result of a seed does not depend on how the blocks are claimed.
+ */
+static constexpr uint64_t sampleBlockSize = 4096;
+
+/**
+ * Share of the sample blocks of every run taken by one of several independent processes, a contiguous range of
+ * the blocks. Shards with the same seed sample disjoint blocks, together exactly the blocks of an unsharded run.
+ */
+struct SampleShard {
+	uint32_t index = 0;
+	uint32_t count = 1;
+
+	uint64_t getFirstBlock(uint64_t nrBlocks) const noexcept {
+		/*	nrBlocks * index / count, without overflowing.	*/
+		return (nrBlocks / count) * index + (nrBlocks % count) * index / count;
+	}
+
+	uint64_t getLastBlock(uint64_t nrBlocks) const noexcept {
+		return SampleShard{index + 1, count}.getFirstBlock(nrBlocks);
+	}
+};
+
+/**
+ * Hands out ranges of sample blocks from a shared lock-free cursor. Every worker sizes its next
+ * claim from its own measured throughput, bounded by a share of the remaining blocks so that the
+ * tail of a run is spread over all the workers (guided self-scheduling).
+ */
+class SampleRangeScheduler {
+  public:
+	/*	Target duration of a claimed range, long enough to amortize the claim.	*/
+	static constexpr double targetChunkSeconds = 0.05;
+
+	/**
+	 * The blocks before firstBlock are not handed out, for continuing a run.
+	 */
+	SampleRangeScheduler(uint64_t nrBlocks, unsigned int nrWorkers, uint64_t firstBlock = 0) noexcept
+		: SampleRangeScheduler(nrBlocks, nrWorkers, SampleShard(), firstBlock) {}
+
+	/**
+	 * Only the blocks of the shard are handed out, from firstBlock when continuing a run.
+	 */
+	SampleRangeScheduler(uint64_t nrBlocks, unsigned int nrWorkers, const SampleShard &shard,
+						 uint64_t firstBlock = 0) noexcept
+		: nrBlocks(nrBlocks), lastBlock(shard.getLastBlock(nrBlocks)), nrWorkers(std::max(1u, nrWorkers)),
+		  cursor(std::min(std::max(firstBlock, shard.getFirstBlock(nrBlocks)), lastBlock)) {}
+
+	/**
+	 * Claim up to preferredBlocks blocks starting at firstBlock. Returns the number of blocks
+	 * claimed, 0 once every block has been handed out or while paused.
+	 */
+	uint64_t claim(uint64_t preferredBlocks, uint64_t &firstBlock) noexcept {
+		uint64_t current = cursor.load(std::memory_order_relaxed);
+		while (current < lastBlock && !paused.load(std::memory_order_relaxed)) {
+			const uint64_t remaining = lastBlock - current;
+			const uint64_t share = (remaining + 2 * nrWorkers - 1) / (2 * nrWorkers);
+			const uint64_t count = std::max<uint64_t>(1, std::min(preferredBlocks, share));
+			if (cursor.compare_exchange_weak(current, current + count, std::memory_order_relaxed)) {
+				firstBlock = current;
+				return count;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * Stop handing out blocks, the ranges already claimed are still processed.
+	 */
+	void stop() noexcept { cursor.store(lastBlock, std::memory_order_relaxed); }
+
+	/**
+	 * Stop handing out blocks until resumed. Once the ranges already claimed are processed, every block
+	 * before getNextBlock has been processed and none after it.
+	 */
+	void pause() noexcept { paused.store(true, std::memory_order_relaxed); }
+
+	void resume() noexcept { paused.store(false, std::memory_order_relaxed); }
+
+	bool isPaused() const noexcept { return paused.load(std::memory_order_relaxed); }
+
+	uint64_t getNextBlock() const noexcept { return std::min(cursor.load(std::memory_order_relaxed), lastBlock); }
+
+	/**
+	 * Number of blocks to claim next, for a worker that processed nrBlocks in the given seconds.
+	 */
+	static uint64_t tuneChunk(uint64_t nrBlocks, double seconds) noexcept {
+		if (seconds <= 0) {
+			return nrBlocks * 2;
+		}
+		/*	Grow at most by a factor of two per claim, so a single fast measurement does not overshoot.	*/
+		const double tuned = static_cast<double>(nrBlocks) * targetChunkSeconds / seconds;
+		return std::max<uint64_t>(1, std::min<uint64_t>(nrBlocks * 2, static_cast<uint64_t>(tuned)));
+	}
+
+	uint64_t getNrBlocks() const noexcept { return nrBlocks; }
+
+	/**
+	 * Number of blocks holding nrSamples, the last block holds the remainder.
+	 */
+	static uint64_t getNrBlocks(uint64_t nrSamples) noexcept {
+		return (nrSamples + sampleBlockSize - 1) / sampleBlockSize;
+	}
+
+	/**
+	 * Number of samples of a block, within a run of nrSamples.
+	 */
+	static uint64_t getBlockSamples(uint64_t block, uint64_t nrSamples) noexcept {
+		return std::min(sampleBlockSize, nrSamples - block * sampleBlockSize);
+	}
+
+	/**
+	 * Number of samples of the blocks from firstBlock to lastBlock, within a run of nrSamples.
+	 */
+	static uint64_t getRangeSamples(uint64_t firstBlock, uint64_t lastBlock, uint64_t nrSamples) noexcept {
+		return std::min(nrSamples, lastBlock * sampleBlockSize) - std::min(nrSamples, firstBlock * sampleBlockSize);
+	}
+
+	/**
+	 * Number of samples of the shard, within a run of nrSamples.
+	 */
+	static uint64_t getShardSamples(const SampleShard &shard, uint64_t nrSamples) noexcept {
+		const uint64_t nrBlocks = getNrBlocks(nrSamples);
+		return getRangeSamples(shard.getFirstBlock(nrBlocks), shard.getLastBlock(nrBlocks), nrSamples);
+	}
+
+  private:
+	const uint64_t nrBlocks;
+	const uint64_t lastBlock;
+	const unsigned int nrWorkers;
+	alignas(64) std::atomic_uint64_t cursor;
+	std::atomic_bool paused{false};
+};
@@ -1,6 +1,25 @@
 #define CRCPP_USE_CPP11
 #define CRCPP_INCLUDE_ESOTERIC_CRC_DEFINITIONS
+#include "CRCAlgorithm.h"
+#include "CRCAnalytic.h"
+#include "CRCBurst.h"
+#include "CRCCheckpoint.h"
+#include "CRCCombine.h"
+#include "CRCCorpus.h"
+#include "CRCCorrection.h"
+#include "CRCCounters.h"
+#include "CRCErrorModel.h"
+#include "CRCExhaustive.h"
+#include "CRCHardware.h"
+#include "CRCImportance.h"
+#include "CRCProfile.h"
+#include "CRCResults.h"
+#include "CRCSearch.h"
+#include "CRCStatistics.h"
+#include "CRCSweep.h"
+#include "CRCSyndrome.h"
 #include "RandGenerator.h"
+#include "SampleScheduler.h"
 #include "marl/defer.h"
 #include "marl/event.h"
 #include "marl/scheduler.h"
@@ -8,149 +27,25 @@
 #include "marl/waitgroup.h"
 #include "revision.h"
 #include <CRC.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <cxxopts.hpp>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
 #include <stdexcept>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
-enum CRCAlgorithm {
-	CRC4_ITU,
-	CRC5_EPC,
-	CRC5_ITU,
-	CRC5_USB,
-	CRC6_CDMA2000A,
-	CRC6_CDMA2000B,
-	CRC6_ITU,
-	CRC6_NR,
-	CRC7,
-	CRC8,
-	CRC8_EBU,
-	CRC8_MAXIM,
-	CRC8_WCDMA,
-	CRC8_LTE,
-	CRC10,
-	CRC10_CDMA2000,
-	CRC11,
-	CRC11_NR,
-	CRC12_CDMA2000,
-	CRC12_DECT,
-	CRC12_UMTS,
-	CRC13_BCC,
-	CRC15,
-	CRC15_MPT1327,
-	CRC16_ARC,
-	CRC16_BUYPASS,
-	CRC16_MCRF4XX,
-	CRC16_CCITTFALSE,
-	CRC16_CDMA2000,
-	CRC16_CMS,
-	CRC16_DECTR,
-	CRC16_DECTX,
-	CRC16_DNP,
-	CRC16_GENIBUS,
-	CRC16_KERMIT,
-	CRC16_MAXIM,
-	CRC16_MODBUS,
-	CRC16_T10DIF,
-	CRC16_USB,
-	CRC16_X25,
-	CRC16_XMODEM,
-	CRC17_CAN,
-	CRC21_CAN,
-	CRC24,
-	CRC24_FLEXRAYA,
-	CRC24_FLEXRAYB,
-	CRC24_LTEA,
-	CRC24_LTEB,
-	CRC24_NRC,
-	CRC30,
-	CRC32,
-	CRC32_BZIP2,
-	CRC32_C,
-	CRC32_MPEG2,
-	CRC32_POSIX,
-	CRC32_Q,
-	CRC40_GSM,
-	CRC64,
-	XOR8,
-	XOR16,
-	XOR32,
-	XOR8_MASK_MAJOR_BIT,
-};
-
-static std::unordered_map<std::string, CRCAlgorithm> const table = {
-	{"crc4_itu", CRCAlgorithm::CRC4_ITU},
-	{"crc5_epc", CRCAlgorithm::CRC5_EPC},
-	{"crc5_itu", CRCAlgorithm::CRC5_ITU},
-	{"crc5_usb", CRCAlgorithm::CRC5_USB},
-	{"crc6_cmda2000a", CRCAlgorithm::CRC6_CDMA2000A},
-	{"crc6_cmda2000b", CRCAlgorithm::CRC6_CDMA2000B},
-	{"crc6_itu", CRCAlgorithm::CRC6_ITU},
-	{"crc6_nr", CRCAlgorithm::CRC6_NR},
-
-	{"crc7", CRCAlgorithm::CRC7},
-	{"crc8", CRCAlgorithm::CRC8},
-
-	{"crc8_ebu", CRCAlgorithm::CRC8_EBU},
-	{"crc8_maxim", CRCAlgorithm::CRC8_MAXIM},
-	{"crc8_wcdma", CRCAlgorithm::CRC8_WCDMA},
-	{"crc8_lte", CRCAlgorithm::CRC8_LTE},
-
-	{"crc10", CRCAlgorithm::CRC10},
-	{"crc10_cdma2000", CRCAlgorithm::CRC10_CDMA2000},
-	{"crc11", CRCAlgorithm::CRC11},
-	{"crc11_nr", CRCAlgorithm::CRC11_NR},
-	{"crc12_cdma2000", CRCAlgorithm::CRC12_CDMA2000},
-	{"crc12_dect", CRCAlgorithm::CRC12_DECT},
-	{"crc12_umts", CRCAlgorithm::CRC12_UMTS},
-	{"crc13_bcc", CRCAlgorithm::CRC13_BCC},
-	{"crc15", CRCAlgorithm::CRC15},
-	{"crc15_mpt1327", CRCAlgorithm::CRC15_MPT1327},
-	{"crc16_arc", CRCAlgorithm::CRC16_ARC},
-	{"crc16_buypass", CRCAlgorithm::CRC16_BUYPASS},
-	{"crc16_mcrf4xx", CRCAlgorithm::CRC16_MCRF4XX},
-	{"crc16_ccittfalse", CRCAlgorithm::CRC16_CCITTFALSE},
-	{"crc16_cdma2000", CRCAlgorithm::CRC16_CDMA2000},
-	{"crc16_cms", CRCAlgorithm::CRC16_CMS},
-	{"crc16_dectr", CRCAlgorithm::CRC16_DECTR},
-	{"crc16_dectx", CRCAlgorithm::CRC16_DECTX},
-	{"crc16_dnp", CRCAlgorithm::CRC16_DNP},
-	{"crc16_genibus", CRCAlgorithm::CRC16_GENIBUS},
-	{"crc16_kermit", CRCAlgorithm::CRC16_KERMIT},
-	{"crc16_maxim", CRCAlgorithm::CRC16_MAXIM},
-	{"crc16_modbus", CRCAlgorithm::CRC16_MODBUS},
-	{"crc16_t10dif", CRCAlgorithm::CRC16_T10DIF},
-	{"crc16_usb", CRCAlgorithm::CRC16_USB},
-	{"crc16_x25", CRCAlgorithm::CRC16_X25},
-	{"crc16_xmodem", CRCAlgorithm::CRC16_XMODEM},
-	{"crc17_can", CRCAlgorithm::CRC17_CAN},
-	{"crc21_can", CRCAlgorithm::CRC21_CAN},
-	{"crc24", CRCAlgorithm::CRC24},
-	{"crc24_flexraya", CRCAlgorithm::CRC24_FLEXRAYA},
-	{"crc24_flexrayb", CRCAlgorithm::CRC24_FLEXRAYB},
-	{"crc24_ltea", CRCAlgorithm::CRC24_LTEA},
-	{"crc24_lteb", CRCAlgorithm::CRC24_LTEB},
-	{"crc24_nrc", CRCAlgorithm::CRC24_NRC},
-
-	{"crc30", CRCAlgorithm::CRC30},
-	{"crc32", CRCAlgorithm::CRC32},
-	{"crc32_bzip2", CRCAlgorithm::CRC32_BZIP2},
-	{"crc32_c", CRCAlgorithm::CRC32_C},
-	{"crc32_mpeg2", CRCAlgorithm::CRC32_MPEG2},
-	{"crc32_posix", CRCAlgorithm::CRC32_POSIX},
-	{"crc32_q", CRCAlgorithm::CRC32_Q},
-	{"crc40_gsm", CRCAlgorithm::CRC40_GSM},
-	{"crc64", CRCAlgorithm::CRC64},
-	{"xor8", CRCAlgorithm::XOR8},
-	{"xor16", CRCAlgorithm::XOR16},
-	{"xor32", CRCAlgorithm::XOR32},
-	{"xor8_masked", CRCAlgorithm::XOR8_MASK_MAJOR_BIT}};
-
 template <typename Result, size_t n = 8, typename T>
 static Result computeXOR(const std::vector<T> &data, Result mask = 0xFF) {
 
@@ -167,7 +62,36 @@ static Result computeXOR(const std::vector<T> &data, Result mask = 0xFF) {
 	return checksum & mask;
 }
 
-template <typename T> static uint64_t computeCRC(CRCAlgorithm algorithm, const std::vector<T> &in) {
+/**
+ * Bit at a time CRC with the parameters of the custom kernel, the reference for validating it.
+ */
+template <typename T> static uint64_t computeCustomReferenceCRC(const std::vector<T> &in) {
+	const CRCParameters &parameters = CRCCustomKernel::getParameters();
+	const uint64_t topBit = static_cast<uint64_t>(1) << (parameters.width - 1);
+	const uint64_t mask = parameters.width >= 64 ? ~static_cast<uint64_t>(0) : (topBit << 1) - 1;
+	const uint8_t *p = reinterpret_cast<const uint8_t *>(in.data());
+
+	uint64_t crc = parameters.initialValue & mask;
+	for (size_t i = 0; i < in.size() * sizeof(T); i++) {
+		const uint8_t byte = parameters.reflectInput ? reflectBits<uint8_t>(p[i], 8) : p[i];
+		for (int bit = 7; bit >= 0; bit--) {
+			const bool carry = ((crc & topBit) != 0) != (((byte >> bit) & 1) != 0);
+			crc = (crc << 1) & mask;
+			if (carry) {
+				crc ^= parameters.polynomial;
+			}
+		}
+	}
+	if (parameters.reflectOutput) {
+		crc = reflectBits<uint64_t>(crc, parameters.width);
+	}
+	return (crc ^ parameters.finalXOR) & mask;
+}
+
+/**
+ * CRCpp reference implementation, used for validating the compile-time kernels.
+ */
+template <typename T> static uint64_t computeReferenceCRC(CRCAlgorithm algorithm, const std::vector<T> &in) {
 	const std::size_t nrBytes = in.size() * sizeof(T);
 	const void *pData = in.data();
 
@@ -412,87 +336,1481 @@ template <typename T> static uint64_t computeCRC(CRCAlgorithm algorithm, const s
 		return computeXOR<uint32_t, 32>(in);
 	case XOR8_MASK_MAJOR_BIT:
 		return computeXOR<uint8_t, 8>(in, 0x7F);
+	case CRC_CUSTOM:
+		return computeCustomReferenceCRC(in);
 	default:
 		assert(0);
 		return 0;
 	}
 }
 
-template <typename T> void generateRandomMessage(std::vector<T> &data, unsigned int size, RandGenerator &gen) {
-	assert(data.size() <= size);
-	for (unsigned int i = 0; i < size; i++) {
-		data[i] = gen.getRandom();
+template <typename Kernel, typename T> static inline uint64_t computeCRC(const std::vector<T> &in) {
+	return Kernel::compute(in.data(), in.size() * sizeof(T));
+}
+
+template <typename T> void generateRandomMessage(std::vector<T> &data, size_t size, PCGBatchRandom &gen) {
+	static_assert(sizeof(T) == sizeof(uint32_t), "Messages are filled a 32-bit word at a time");
+	assert(size <= data.size());
+	gen.fill(reinterpret_cast<uint32_t *>(data.data()), size);
+}
+
+/**
+ * Flip the bit indices of the message in place, flipping them again restores the message.
+ */
+template <typename T> void flipBitErrors(std::vector<T> &data, const uint32_t *bitIndices, const unsigned int nrFlipped) {
+	const uint32_t elementNrBits = sizeof(T) * 8;
+
+	for (unsigned int i = 0; i < nrFlipped; i++) {
+		const uint32_t bitIndex = bitIndices[i];
+
+		/*	Convert a bit index to array index and bit offset.	*/
+		const uint32_t arrayIndex = bitIndex / elementNrBits;
+		const uint32_t bitFlipIndex = bitIndex % elementNrBits;
+		assert(arrayIndex < data.size());
+
+		/*	Flip a single bit.	*/
+		data[arrayIndex] ^= (static_cast<T>(1) << bitFlipIndex);
 	}
 }
 
+/**
+ * Flip the bit indices of a single lane of an interleaved block.
+ */
 template <typename T>
-void setFlippedBitErrors(const std::vector<T> &in, std::vector<T> &out, RandGenerator &gen,
-						 const unsigned int nrBitError, const float probability) {
+void setFlippedInterleavedBitErrors(std::vector<T> &block, uint32_t nrLanes, uint32_t lane, const uint32_t *bitIndices,
+									const unsigned int nrFlipped) {
 	const uint32_t elementNrBits = sizeof(T) * 8;
-	const uint32_t dataBitSize = in.size() * elementNrBits;
 
-	assert(in.size() == out.size());
+	for (unsigned int i = 0; i < nrFlipped; i++) {
+		const uint32_t arrayIndex = (bitIndices[i] / elementNrBits) * nrLanes + lane;
+		assert(arrayIndex < block.size());
+
+		block[arrayIndex] ^= (static_cast<T>(1) << (bitIndices[i] % elementNrBits));
+	}
+}
+
+typedef uint32_t CRCInt;
+
+/*	Largest message in bytes, the bit positions of the errors are 32-bit.	*/
+static constexpr uint64_t maxMessageSize =
+	(static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) + 1) / 8 - sizeof(CRCInt);
+
+/**
+ * Sampling parameters shared by every task.
+ */
+struct SampleOptions {
+	uint64_t dataSize; /*	Number of CRCInt per message.	*/
+	uint32_t nrBitError;
+	float probability;
+	bool incremental;
+	uint32_t batchLanes;
+	uint64_t seed; /*	Every task derives its random streams from the seed and its stream id.	*/
+	ErrorModel errorModel = ErrorModel::Trials;
+	double logNoError = 0; /*	log(1 - ber) of the channel model.	*/
+	uint32_t burstLength = 0;
+	SampleShard shard; /*	Blocks of every run sampled by this process.	*/
+	const MessageCorpus *corpus = nullptr; /*	Source of the messages instead of the random streams, if any.	*/
+	uint64_t chunkSize = 0; /*	Bytes of a message hashed by a single task, 0 to hash the message serially.	*/
+};
+
+/**
+ * Index of the corpus message of the first sample of the stream, the samples of consecutive streams take
+ * consecutive messages, wrapping around the corpus.
+ */
+static inline uint64_t getFirstCorpusMessage(const MessageCorpus &corpus, uint64_t streamId) noexcept {
+	return (streamId % corpus.getNrMessages()) * (sampleBlockSize % corpus.getNrMessages()) % corpus.getNrMessages();
+}
+
+/*	Number of lanes hashed together by a single interleaved loop, and the largest batch.	*/
+static constexpr uint32_t batchLaneGroup = 8;
+static constexpr uint32_t batchMaxLanes = 64;
+
+/**
+ * Draw the bit indices of the error of a message with the error model of the options, appended to bitIndices.
+ * Returns the number of bit indices appended.
+ */
+static unsigned int generateErrorIndices(const SampleOptions &options, uint32_t dataBitSize, PCGRandom &gen,
+										 std::vector<uint32_t> &bitIndices) {
+	if (options.errorModel == ErrorModel::Channel) {
+		return generateChannelBitErrorIndices(dataBitSize, gen, options.logNoError, bitIndices);
+	}
+	if (options.errorModel == ErrorModel::Burst) {
+		return generateBurstBitErrorIndices(dataBitSize, gen, options.burstLength, bitIndices);
+	}
+
+	const size_t nrPrevious = bitIndices.size();
+	bitIndices.resize(nrPrevious + options.nrBitError);
+	const unsigned int nrFlipped =
+		options.errorModel == ErrorModel::Distinct
+			? generateDistinctBitErrorIndices(dataBitSize, gen, options.nrBitError, options.probability,
+											  &bitIndices[nrPrevious])
+			: generateBitErrorIndices(dataBitSize, gen, options.nrBitError, options.probability, &bitIndices[nrPrevious]);
+	bitIndices.resize(nrPrevious + nrFlipped);
+	return nrFlipped;
+}
+
+/**
+ * Sample random messages with bit errors one at a time and count the undetected errors.
+ * Returns the number of collisions. When profiled, the phases of the timed samples are added to the profile.
+ */
+template <typename Kernel, bool isProfiled = false>
+static uint64_t sampleCollisions(const SampleOptions &options, const ErrorSyndromes &syndromes,
+								 uint64_t nrSamples, uint64_t streamId, SampleProfile *profile = nullptr) {
+	/*	The random message flipped in place, unused with a corpus.	*/
+	std::vector<CRCInt> originalMsg(options.corpus != nullptr ? 0 : options.dataSize);
+	std::vector<uint32_t> bitIndices;
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	const size_t nrBytes = options.dataSize * sizeof(CRCInt);
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
+	uint64_t nrCollision = 0;
+	uint64_t corpusIndex = options.corpus != nullptr ? getFirstCorpusMessage(*options.corpus, streamId) : 0;
+	const ChunkedCRC chunked = ChunkedCRC::create<Kernel>(nrBytes, options.chunkSize);
+
+	/*	The corpus is read-only, its error messages are hashed as CRC(msg ^ e) = CRC(msg) ^ CRC(e) ^ CRC(0) with the
+	 *	error alone flipped into a zero message and back, instead of copying every message.	*/
+	std::vector<CRCInt> errorScratch(options.corpus != nullptr && !options.incremental ? options.dataSize : 0);
+	const uint64_t zeroMsgCRC = errorScratch.empty() ? 0 : chunked.compute(errorScratch.data());
+
+	/*	*/
+	for (uint64_t i = 0; i < nrSamples; i++) {
+		SamplePhaseTimer<isProfiled> timer(profile);
+		const void *message = originalMsg.data();
+		if (options.corpus != nullptr) {
+			message = options.corpus->getMessage(corpusIndex);
+			corpusIndex = corpusIndex + 1 < options.corpus->getNrMessages() ? corpusIndex + 1 : 0;
+		} else {
+			generateRandomMessage(originalMsg, options.dataSize, randGen);
+		}
+		timer.mark(SamplePhase::Message);
+		bitIndices.clear();
+		const unsigned int nrFlipped = generateErrorIndices(options, dataBitSize, bitRandGen, bitIndices);
+		timer.mark(SamplePhase::Error);
+
+		std::uint64_t originalMsgCRC, errorMsgCRC;
+
+		/*	*/
+		originalMsgCRC = chunked.compute(message);
+		timer.mark(SamplePhase::CRC);
+		if (options.incremental) {
+			/*	CRC(msg ^ e) = CRC(msg) ^ CRC0(e), no need to copy or rehash the message.	*/
+			errorMsgCRC = originalMsgCRC ^ syndromes.computeErrorSyndrome(bitIndices.data(), nrFlipped);
+		} else if (options.corpus != nullptr) {
+			flipBitErrors(errorScratch, bitIndices.data(), nrFlipped);
+			errorMsgCRC = originalMsgCRC ^ chunked.compute(errorScratch.data()) ^ zeroMsgCRC;
+			flipBitErrors(errorScratch, bitIndices.data(), nrFlipped);
+		} else {
+			/*	Hash the error message in place and restore the message.	*/
+			flipBitErrors(originalMsg, bitIndices.data(), nrFlipped);
+			errorMsgCRC = chunked.compute(originalMsg.data());
+			flipBitErrors(originalMsg, bitIndices.data(), nrFlipped);
+		}
+		timer.mark(SamplePhase::ErrorCRC);
+		const bool isMsgEqual = isErrorEmpty(options.errorModel, bitIndices.data(), nrFlipped);
+
+		/*	If message are not equal but the CRC are equal means that there was a incorrect CRC!	*/
+		if (!isMsgEqual && originalMsgCRC == errorMsgCRC) {
+			nrCollision++;
+		}
+		timer.mark(SamplePhase::Compare);
+	}
+	return nrCollision;
+}
+
+/**
+ * Compute the CRC of every lane of an interleaved block, word i of lane l at block[i * nrLanes + l].
+ */
+template <typename Kernel>
+static void computeInterleavedCRC(const std::vector<CRCInt> &block, uint32_t nrWords, uint32_t nrLanes,
+								  uint64_t *crcs) {
+	for (uint32_t lane = 0; lane < nrLanes; lane += batchLaneGroup) {
+		Kernel::template computeInterleaved<batchLaneGroup>(&block[lane], nrWords, nrLanes, &crcs[lane]);
+	}
+}
+
+/**
+ * Sample a structure-of-arrays block of messages at a time, hashing all lanes interleaved.
+ * Collisions are tallied per batch. Returns the number of collisions.
+ */
+template <typename Kernel>
+static uint64_t sampleCollisionsBatched(const SampleOptions &options, const ErrorSyndromes &syndromes,
+										uint64_t nrSamples, uint64_t streamId) {
+	const uint32_t nrLanes = options.batchLanes;
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	std::vector<CRCInt> originalBlock(options.dataSize * nrLanes);
+	std::vector<CRCInt> errorBlock(options.dataSize * nrLanes);
+	std::vector<uint64_t> originalCRCs(nrLanes);
+	std::vector<uint64_t> errorCRCs(nrLanes);
+	std::vector<uint8_t> isLaneChanged(nrLanes);
+	std::vector<uint32_t> bitIndices;
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
+	uint64_t nrCollision = 0;
+
+	for (uint64_t i = 0; i < nrSamples; i += nrLanes) {
+		const uint64_t nrActiveLanes = std::min<uint64_t>(nrLanes, nrSamples - i);
+
+		generateRandomMessage(originalBlock, originalBlock.size(), randGen);
+		if (!options.incremental) {
+			errorBlock = originalBlock;
+		}
+
+		for (uint32_t lane = 0; lane < nrLanes; lane++) {
+			bitIndices.clear();
+			const unsigned int nrFlipped = generateErrorIndices(options, dataBitSize, bitRandGen, bitIndices);
+			if (options.incremental) {
+				errorCRCs[lane] = syndromes.computeErrorSyndrome(bitIndices.data(), nrFlipped);
+			} else {
+				setFlippedInterleavedBitErrors(errorBlock, nrLanes, lane, bitIndices.data(), nrFlipped);
+			}
+			isLaneChanged[lane] = !isErrorEmpty(options.errorModel, bitIndices.data(), nrFlipped);
+		}
+
+		computeInterleavedCRC<Kernel>(originalBlock, options.dataSize, nrLanes, originalCRCs.data());
+		if (options.incremental) {
+			for (uint32_t lane = 0; lane < nrLanes; lane++) {
+				errorCRCs[lane] ^= originalCRCs[lane];
+			}
+		} else {
+			computeInterleavedCRC<Kernel>(errorBlock, options.dataSize, nrLanes, errorCRCs.data());
+		}
+
+		uint64_t batchCollision = 0;
+		for (uint32_t lane = 0; lane < nrActiveLanes; lane++) {
+			batchCollision += isLaneChanged[lane] && originalCRCs[lane] == errorCRCs[lane];
+		}
+		nrCollision += batchCollision;
+	}
+	return nrCollision;
+}
+
+/**
+ * Type erased algorithm, for evaluating several algorithms against the same samples.
+ */
+struct SampleAlgorithm {
+	std::string name;
+	CRCAlgorithm algorithm;
+	uint64_t (*compute)(const void *data, size_t size);
+	ChunkedCRC (*createChunked)(uint64_t messageSize, uint64_t chunkSize);
+	void (*computeInterleaved)(const std::vector<CRCInt> &block, uint32_t nrWords, uint32_t nrLanes, uint64_t *crcs);
+	ErrorSyndromes syndromes;
+};
+
+/**
+ * Per-bit syndrome table of the options, indexed by the transmitted bit position for bursts.
+ */
+template <typename Kernel> static std::vector<uint64_t> createSampleSyndromeTable(const SampleOptions &options) {
+	std::vector<uint64_t> syndromes = createSyndromeTable<Kernel>(options.dataSize * sizeof(CRCInt));
+	return options.errorModel == ErrorModel::Burst ? BurstSyndromes(syndromes).getColumns() : syndromes;
+}
+
+/**
+ * Syndromes of the errors of the options, none unless incremental. Messages whose table would exceed
+ * maxSampleSyndromeTableSize use the sparse syndromes, except for bursts whose bit order is derived from the table.
+ */
+template <typename Kernel> static ErrorSyndromes createSampleSyndromes(const SampleOptions &options) {
+	if (!options.incremental) {
+		return ErrorSyndromes();
+	}
+	const uint64_t nrBytes = options.dataSize * sizeof(CRCInt);
+	if (options.errorModel != ErrorModel::Burst && nrBytes * 8 * sizeof(uint64_t) > maxSampleSyndromeTableSize) {
+		return ErrorSyndromes(SparseSyndromes::create<Kernel>(nrBytes));
+	}
+	return ErrorSyndromes(createSampleSyndromeTable<Kernel>(options));
+}
+
+template <typename Kernel>
+static SampleAlgorithm createSampleAlgorithm(const std::string &name, CRCAlgorithm algorithm,
+											 const SampleOptions &options) {
+	return {name, algorithm, &Kernel::compute, &ChunkedCRC::create<Kernel>, &computeInterleavedCRC<Kernel>,
+			createSampleSyndromes<Kernel>(options)};
+}
+
+/**
+ * Sample random messages with bit errors one at a time and evaluate each of them against every algorithm.
+ * Draws the same messages and errors as sampleCollisions for the same stream id. nrCollisions holds
+ * one counter per algorithm, owned by the calling task.
+ */
+static void sampleCollisionsMulti(const SampleOptions &options, const std::vector<SampleAlgorithm> &algorithms,
+								  uint64_t nrSamples, uint64_t streamId, uint64_t *nrCollisions) {
+	std::vector<CRCInt> originalMsg(options.corpus != nullptr ? 0 : options.dataSize);
+	std::vector<uint32_t> bitIndices;
+	std::vector<uint64_t> originalCRCs(algorithms.size());
+	std::vector<uint64_t> collisions(algorithms.size(), 0);
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	const size_t nrBytes = options.dataSize * sizeof(CRCInt);
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
+	uint64_t corpusIndex = options.corpus != nullptr ? getFirstCorpusMessage(*options.corpus, streamId) : 0;
+	std::vector<ChunkedCRC> chunked;
+	for (const SampleAlgorithm &algorithm : algorithms) {
+		chunked.push_back(algorithm.createChunked(nrBytes, options.chunkSize));
+	}
+
+	/*	The read-only corpus messages are not copied, as in sampleCollisions the error alone is hashed from a zero
+	 *	message, CRC(msg ^ e) = CRC(msg) ^ CRC(e) ^ CRC(0).	*/
+	std::vector<CRCInt> errorScratch(options.corpus != nullptr && !options.incremental ? options.dataSize : 0);
+	std::vector<uint64_t> zeroMsgCRCs(algorithms.size(), 0);
+	for (size_t a = 0; a < algorithms.size() && !errorScratch.empty(); a++) {
+		zeroMsgCRCs[a] = chunked[a].compute(errorScratch.data());
+	}
+
+	for (uint64_t i = 0; i < nrSamples; i++) {
+		const void *message = originalMsg.data();
+		if (options.corpus != nullptr) {
+			message = options.corpus->getMessage(corpusIndex);
+			corpusIndex = corpusIndex + 1 < options.corpus->getNrMessages() ? corpusIndex + 1 : 0;
+		} else {
+			generateRandomMessage(originalMsg, options.dataSize, randGen);
+		}
+		bitIndices.clear();
+		const unsigned int nrFlipped = generateErrorIndices(options, dataBitSize, bitRandGen, bitIndices);
+
+		/*	Whether the message changed does not depend on the algorithm.	*/
+		if (isErrorEmpty(options.errorModel, bitIndices.data(), nrFlipped)) {
+			continue;
+		}
+
+		if (options.incremental) {
+			for (size_t a = 0; a < algorithms.size(); a++) {
+				const uint64_t originalMsgCRC = chunked[a].compute(message);
+				const uint64_t errorMsgCRC =
+					originalMsgCRC ^ algorithms[a].syndromes.computeErrorSyndrome(bitIndices.data(), nrFlipped);
+				collisions[a] += originalMsgCRC == errorMsgCRC;
+			}
+		} else if (options.corpus != nullptr) {
+			flipBitErrors(errorScratch, bitIndices.data(), nrFlipped);
+			for (size_t a = 0; a < algorithms.size(); a++) {
+				const uint64_t originalMsgCRC = chunked[a].compute(message);
+				const uint64_t errorMsgCRC = originalMsgCRC ^ chunked[a].compute(errorScratch.data()) ^ zeroMsgCRCs[a];
+				collisions[a] += originalMsgCRC == errorMsgCRC;
+			}
+			flipBitErrors(errorScratch, bitIndices.data(), nrFlipped);
+		} else {
+			/*	Hash the error message in place and restore the message.	*/
+			for (size_t a = 0; a < algorithms.size(); a++) {
+				originalCRCs[a] = chunked[a].compute(message);
+			}
+			flipBitErrors(originalMsg, bitIndices.data(), nrFlipped);
+			for (size_t a = 0; a < algorithms.size(); a++) {
+				collisions[a] += originalCRCs[a] == chunked[a].compute(originalMsg.data());
+			}
+			flipBitErrors(originalMsg, bitIndices.data(), nrFlipped);
+		}
+	}
+
+	for (size_t a = 0; a < algorithms.size(); a++) {
+		nrCollisions[a] += collisions[a];
+	}
+}
+
+/**
+ * Batched counterpart of sampleCollisionsMulti, draws the same messages and errors as sampleCollisionsBatched.
+ */
+static void sampleCollisionsMultiBatched(const SampleOptions &options, const std::vector<SampleAlgorithm> &algorithms,
+										 uint64_t nrSamples, uint64_t streamId, uint64_t *nrCollisions) {
+	const uint32_t nrLanes = options.batchLanes;
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	std::vector<CRCInt> originalBlock(options.dataSize * nrLanes);
+	std::vector<CRCInt> errorBlock(options.dataSize * nrLanes);
+	std::vector<uint64_t> originalCRCs(nrLanes);
+	std::vector<uint64_t> errorCRCs(nrLanes);
+	std::vector<uint8_t> isLaneChanged(nrLanes);
+	/*	The bit indices of every lane are kept, the syndromes are looked up once per algorithm.	*/
+	std::vector<uint32_t> bitIndices;
+	std::vector<size_t> laneBitIndices(nrLanes);
+	std::vector<unsigned int> nrLaneFlipped(nrLanes);
+	std::vector<uint64_t> collisions(algorithms.size(), 0);
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
+
+	for (uint64_t i = 0; i < nrSamples; i += nrLanes) {
+		const uint64_t nrActiveLanes = std::min<uint64_t>(nrLanes, nrSamples - i);
+
+		generateRandomMessage(originalBlock, originalBlock.size(), randGen);
+		if (!options.incremental) {
+			errorBlock = originalBlock;
+		}
+
+		bitIndices.clear();
+		for (uint32_t lane = 0; lane < nrLanes; lane++) {
+			laneBitIndices[lane] = bitIndices.size();
+			nrLaneFlipped[lane] = generateErrorIndices(options, dataBitSize, bitRandGen, bitIndices);
+			uint32_t *flipped = bitIndices.data() + laneBitIndices[lane];
+			if (!options.incremental) {
+				setFlippedInterleavedBitErrors(errorBlock, nrLanes, lane, flipped, nrLaneFlipped[lane]);
+			}
+			isLaneChanged[lane] = !isErrorEmpty(options.errorModel, flipped, nrLaneFlipped[lane]);
+		}
+
+		for (size_t a = 0; a < algorithms.size(); a++) {
+			const SampleAlgorithm &algorithm = algorithms[a];
+
+			algorithm.computeInterleaved(originalBlock, options.dataSize, nrLanes, originalCRCs.data());
+			if (options.incremental) {
+				for (uint32_t lane = 0; lane < nrLanes; lane++) {
+					errorCRCs[lane] =
+						originalCRCs[lane] ^ algorithm.syndromes.computeErrorSyndrome(
+												 bitIndices.data() + laneBitIndices[lane], nrLaneFlipped[lane]);
+				}
+			} else {
+				algorithm.computeInterleaved(errorBlock, options.dataSize, nrLanes, errorCRCs.data());
+			}
+
+			for (uint32_t lane = 0; lane < nrActiveLanes; lane++) {
+				collisions[a] += isLaneChanged[lane] && originalCRCs[lane] == errorCRCs[lane];
+			}
+		}
+	}
+
+	for (size_t a = 0; a < algorithms.size(); a++) {
+		nrCollisions[a] += collisions[a];
+	}
+}
+
+static inline uint64_t toNanoSeconds(double seconds) noexcept { return static_cast<uint64_t>(seconds * 1e9); }
+
+/**
+ * Report the samples of every worker thread that took part, and its samples per second while busy.
+ */
+static void writeWorkerRecords(ResultsWriter &writer, const ShardedCounters &counters, uint64_t seed) {
+	for (unsigned int i = 0; i < counters.getNrShards(); i++) {
+		const CounterShard &shard = counters.getShard(i);
+		const uint64_t nrSamples = shard.nrSamples.load(std::memory_order_relaxed);
+		if (nrSamples > 0) {
+			writer.write({"worker", "", 0, 0, 0, seed, i, counters.getNrShards(), nrSamples,
+						  shard.nrCollisions.load(std::memory_order_relaxed),
+						  shard.busyNanoSeconds.load(std::memory_order_relaxed) * 1e-9});
+		}
+	}
+}
+
+/*	Interval between the progress records while sampling.	*/
+static constexpr std::chrono::milliseconds progressInterval(500);
+
+/**
+ * Samples, collisions and busy time of a single sampling task.
+ */
+struct SampleTaskTotals {
+	uint64_t nrSamples = 0;
+	uint64_t nrCollisions = 0;
+	double busySeconds = 0;
+};
+
+/**
+ * Run nrTasks marl tasks that claim ranges of sample blocks until every block has been sampled.
+ * sampleBlock(nthTask, block) samples a single block and returns its number of samples and collisions,
+ * reportProgress is called from the calling thread at every progress interval while the tasks run, the tasks
+ * stop claiming blocks once it returns true. Whenever the checkpoint clock is due, the tasks are paused and
+ * saveCheckpoint(nextBlock) is called once every block before nextBlock has been sampled, and none after it. The
+ * tasks then continue, unless asked to terminate.
+ */
+template <typename SampleBlock, typename ReportProgress, typename SaveCheckpoint>
+static std::vector<SampleTaskTotals> runSampleTasks(SampleRangeScheduler &ranges, uint32_t nrTasks,
+													ShardedCounters &counters, SampleBlock &&sampleBlock,
+													ReportProgress &&reportProgress, CheckpointClock &clock,
+													SaveCheckpoint &&saveCheckpoint) {
+	std::vector<SampleTaskTotals> taskTotals(nrTasks);
+
+	while (true) {
+		marl::Event tasksDone(marl::Event::Mode::Manual);
+		marl::WaitGroup tasksExited(nrTasks);
+		std::atomic_uint32_t nrRunningTasks{nrTasks};
+
+		for (uint32_t nthTask = 0; nthTask < nrTasks; nthTask++) {
+			marl::schedule([&, nthTask] {
+				defer(tasksExited.done());
+				SampleTaskTotals &totals = taskTotals[nthTask];
+
+				/*	Start small, the chunk grows with the measured throughput.	*/
+				uint64_t chunkBlocks = 1;
+				uint64_t firstBlock;
+				while (const uint64_t nrClaimed = ranges.claim(chunkBlocks, firstBlock)) {
+					const auto chunkStart = std::chrono::steady_clock::now();
+					uint64_t nrSamples = 0, nrCollisions = 0;
+					for (uint64_t block = firstBlock; block < firstBlock + nrClaimed; block++) {
+						const std::pair<uint64_t, uint64_t> blockTotals = sampleBlock(nthTask, block);
+						nrSamples += blockTotals.first;
+						nrCollisions += blockTotals.second;
+					}
+					const double seconds =
+						std::chrono::duration<double>(std::chrono::steady_clock::now() - chunkStart).count();
+
+					counters.add(nrSamples, nrCollisions, toNanoSeconds(seconds));
+					totals.nrSamples += nrSamples;
+					totals.nrCollisions += nrCollisions;
+					totals.busySeconds += seconds;
+					chunkBlocks = SampleRangeScheduler::tuneChunk(nrClaimed, seconds);
+				}
+
+				if (nrRunningTasks.fetch_sub(1) == 1) {
+					tasksDone.signal();
+				}
+			});
+		}
 
-	// Copy the message
-	out = in;
+		while (!tasksDone.wait_for(progressInterval)) {
+			if (reportProgress()) {
+				ranges.stop();
+			}
+			if (clock.isDue()) {
+				ranges.pause();
+			}
+		}
+		tasksExited.wait();
 
-	for (unsigned int i = 0; i < nrBitError; i++) {
+		if (!ranges.isPaused()) {
+			return taskTotals;
+		}
+		saveCheckpoint(ranges.getNextBlock());
+		clock.restart();
+		if (isTerminationRequested()) {
+			return taskTotals;
+		}
+		ranges.resume();
+	}
+}
 
-		const float normalized_random_value = gen.getRandomNormalized();
+/**
+ * runSampleTasks without checkpoints.
+ */
+template <typename SampleBlock, typename ReportProgress>
+static std::vector<SampleTaskTotals> runSampleTasks(SampleRangeScheduler &ranges, uint32_t nrTasks,
+													ShardedCounters &counters, SampleBlock &&sampleBlock,
+													ReportProgress &&reportProgress) {
+	CheckpointClock disabledClock;
+	return runSampleTasks(ranges, nrTasks, counters, sampleBlock, reportProgress, disabledClock, [](uint64_t) {});
+}
 
-		if (normalized_random_value <= probability) {
-			const uint32_t bitIndex = gen.getRandom() % dataBitSize;
+/**
+ * Sample random messages with nested bit errors, the error of a sample for k bit errors is made of
+ * its first k flips. Every bit error count of the ascending nrBitErrors thereby reuses the message
+ * and the flips of the smaller counts. nrCollisions holds one counter per algorithm and bit error
+ * count, algorithm major, owned by the calling task.
+ */
+static void sampleCollisionsNested(const SampleOptions &options, const std::vector<uint32_t> &nrBitErrors,
+								   const std::vector<SampleAlgorithm> &algorithms, uint64_t nrSamples,
+								   uint64_t streamId, uint64_t *nrCollisions) {
+	const uint32_t maxNrBitError = nrBitErrors.back();
+	const size_t nrCounts = nrBitErrors.size();
+	std::vector<CRCInt> originalMsg(options.dataSize);
+	std::vector<uint32_t> bitIndices(maxNrBitError);
+	std::vector<uint32_t> sortedBitIndices(maxNrBitError);
+	std::vector<unsigned int> nrFlippedPrefix(maxNrBitError + 1, 0);
+	std::vector<uint64_t> originalCRCs(algorithms.size());
+	std::vector<uint64_t> errorSyndromes(algorithms.size());
+	std::vector<uint64_t> collisions(algorithms.size() * nrCounts, 0);
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	const size_t nrBytes = options.dataSize * sizeof(CRCInt);
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
 
-			/*	Convert a bit index to array index and bit offset.	*/
-			const uint32_t arrayIndex = bitIndex / elementNrBits;
-			const uint32_t bitFlipIndex = bitIndex % elementNrBits;
+	for (uint64_t i = 0; i < nrSamples; i++) {
+		generateRandomMessage(originalMsg, options.dataSize, randGen);
 
-			/*	*/
-			assert(bitFlipIndex < elementNrBits);
-			assert(arrayIndex < out.size());
+		/*	Each flip happens with the given probability, keep how many occurred within the first k.	*/
+		unsigned int nrFlipped = 0;
+		for (uint32_t k = 0; k < maxNrBitError; k++) {
+			nrFlipped += options.errorModel == ErrorModel::Distinct
+							 ? generateDistinctBitErrorIndices(dataBitSize, bitRandGen, 1, options.probability,
+															   &bitIndices[nrFlipped], nrFlipped)
+							 : generateBitErrorIndices(dataBitSize, bitRandGen, 1, options.probability,
+													   &bitIndices[nrFlipped]);
+			nrFlippedPrefix[k + 1] = nrFlipped;
+		}
 
-			/*	Flip a single bit.	*/
-			out[arrayIndex] ^= (1 << bitFlipIndex);
+		for (size_t a = 0; a < algorithms.size(); a++) {
+			originalCRCs[a] = algorithms[a].compute(originalMsg.data(), nrBytes);
+			errorSyndromes[a] = 0;
 		}
+
+		/*	The syndromes are extended by the flips added since the previous bit error count.	*/
+		unsigned int nrApplied = 0;
+		for (size_t c = 0; c < nrCounts; c++) {
+			const unsigned int nrPrefix = nrFlippedPrefix[nrBitErrors[c]];
+			std::copy(bitIndices.begin(), bitIndices.begin() + nrPrefix, sortedBitIndices.begin());
+			if (isErrorEmpty(options.errorModel, sortedBitIndices.data(), nrPrefix)) {
+				continue;
+			}
+			if (!options.incremental) {
+				flipBitErrors(originalMsg, bitIndices.data(), nrPrefix);
+			}
+
+			for (size_t a = 0; a < algorithms.size(); a++) {
+				uint64_t errorMsgCRC;
+				if (options.incremental) {
+					errorSyndromes[a] ^=
+						algorithms[a].syndromes.computeErrorSyndrome(&bitIndices[nrApplied], nrPrefix - nrApplied);
+					errorMsgCRC = originalCRCs[a] ^ errorSyndromes[a];
+				} else {
+					errorMsgCRC = algorithms[a].compute(originalMsg.data(), nrBytes);
+				}
+				collisions[a * nrCounts + c] += originalCRCs[a] == errorMsgCRC;
+			}
+			if (!options.incremental) {
+				flipBitErrors(originalMsg, bitIndices.data(), nrPrefix);
+			}
+			nrApplied = nrPrefix;
+		}
+	}
+
+	for (size_t i = 0; i < collisions.size(); i++) {
+		nrCollisions[i] += collisions[i];
 	}
 }
 
-void computeDiff(const std::vector<unsigned int> &in, std::vector<unsigned int> &out) {
-	std::vector<unsigned int> p(in.size());
-	assert(in.size() == out.size());
+/**
+ * Checkpoints of a sampling run, holding the progress it continues from until the first save. Nothing is saved
+ * without a path.
+ */
+struct SampleCheckpointer {
+	std::string path;
+	SampleCheckpoint state;
+	CheckpointClock clock;
+	double previousWallTime = 0; /*	Seconds sampled by the processes the run continues.	*/
+	std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now();
+
+	/**
+	 * Seconds the run sampled for, since runStart and before it was resumed, so that the rate of the restored and
+	 * the new samples is over the time spent on both.
+	 */
+	double getWallTime() const {
+		return previousWallTime + std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+	}
 
-	for (size_t i = 0; i < in.size(); i++) {
-		/*	Compute the difference.	*/
-		p[i] = out[i] ^ in[i];
+	void save(uint64_t nthRun, uint64_t nextBlock, uint64_t nrSamples, const std::vector<uint64_t> &nrCollisions) {
+		if (path.empty()) {
+			return;
+		}
+		state.nthRun = nthRun;
+		state.nextBlock = nextBlock;
+		state.nrSamples = nrSamples;
+		state.nrCollisions = nrCollisions;
+		state.wallTime = getWallTime();
+		if (!writeSampleCheckpoint(path, state)) {
+			std::cerr << "Failed to write the checkpoint " << path << std::endl;
+		}
 	}
+};
+
+/**
+ * Canonical form of the parameters deciding the samples and collisions of a run, identifying it in its
+ * checkpoints. The custom CRC is identified by its parameters, the seed is kept apart.
+ */
+static std::string formatSampleSpec(const std::vector<std::string> &crcNames, const SampleOptions &options,
+									const std::string &sweep, uint64_t samples) {
+	std::string spec = "crc=";
+	for (size_t i = 0; i < crcNames.size(); i++) {
+		spec += (i > 0 ? "+" : "") + crcNames[i];
+		if (crcNames[i] == customCRCName) {
+			const CRCParameters &parameters = CRCCustomKernel::getParameters();
+			char custom[128];
+			snprintf(custom, sizeof(custom), "(0x%" PRIx64 ",%u,0x%" PRIx64 ",0x%" PRIx64 ",%d,%d)",
+					 parameters.polynomial, parameters.width, parameters.initialValue, parameters.finalXOR,
+					 parameters.reflectInput, parameters.reflectOutput);
+			spec += custom;
+		}
+	}
+
+	char parameters[256];
+	snprintf(parameters, sizeof(parameters),
+			 ",size=%lu,b=%u,P=%.9g,model=%d,log-no-error=%.17g,burst=%u,batch=%u,samples=%" PRIu64 ",shard=%u/%u",
+			 (unsigned long)(options.dataSize * sizeof(CRCInt)), options.nrBitError, options.probability,
+			 static_cast<int>(options.errorModel), options.logNoError, options.burstLength, options.batchLanes,
+			 samples, options.shard.index, options.shard.count);
+	if (options.corpus != nullptr) {
+		spec += ",corpus=" + std::to_string(options.corpus->getNrMessages());
+	}
+	return spec + parameters + ",sweep=" + sweep;
 }
 
-void attemptErrorCorrectMsg(const std::vector<unsigned int> &in, std::vector<unsigned int> &out) {}
+/**
+ * Run every cell of the sweep grid on the bound marl scheduler. The blocks of all the cells are claimed
+ * from a single scheduler, so the tasks are load balanced across the cells. A cell is a message size and
+ * error probability, the bit error counts are nested within it. The text format prints a matrix of the
+ * collision rates per algorithm and error probability, message sizes by bit error counts, the others a
+ * record per cell. The checkpoints count the collisions of every cell.
+ */
+static void runSweep(const SweepSpec &sweep, const std::vector<std::string> &crcNames,
+					 const SampleOptions &baseOptions, uint64_t samples, uint32_t numTasks, bool runForever,
+					 ResultsWriter &writer, ShardedCounters &counters, SampleCheckpointer &checkpointer) {
+	const size_t nrSizes = sweep.messageSizes.size();
+	const size_t nrProbabilities = sweep.probabilities.size();
+	const size_t nrCounts = sweep.nrBitErrors.size();
+	const size_t nrAlgorithms = crcNames.size();
+	const size_t nrCells = nrSizes * nrProbabilities;
+	const size_t nrCellCounters = nrAlgorithms * nrCounts;
+
+	/*	The syndrome tables depend on the message size.	*/
+	std::vector<std::vector<SampleAlgorithm>> sizeAlgorithms(nrSizes);
+	std::vector<SampleOptions> cellOptions(nrCells, baseOptions);
+	for (size_t s = 0; s < nrSizes; s++) {
+		for (size_t p = 0; p < nrProbabilities; p++) {
+			SampleOptions &options = cellOptions[s * nrProbabilities + p];
+			options.dataSize = sweep.messageSizes[s] / sizeof(CRCInt);
+			options.nrBitError = sweep.nrBitErrors.back();
+			options.probability = sweep.probabilities[p];
+		}
+		for (const std::string &crcName : crcNames) {
+			const CRCAlgorithm algorithm = crcAlgorithmTable.at(crcName);
+			sizeAlgorithms[s].push_back(dispatchCRCAlgorithm(algorithm, [&](auto kernel) {
+				return createSampleAlgorithm<decltype(kernel)>(crcName, algorithm, cellOptions[s * nrProbabilities]);
+			}));
+		}
+	}
+
+	/*	Continue from the collisions of every cell sampled so far.	*/
+	std::vector<uint64_t> nrCellCollisions = checkpointer.state.nrCollisions;
+	/*	Every task counts into its own slice of every cell, merged once all the tasks completed.	*/
+	std::vector<uint64_t> taskCollisions(nrCells * numTasks * nrCellCounters);
+	std::vector<SampleTaskTotals> taskCellTotals(nrCells * numTasks);
+	const uint64_t nrCellBlocks = SampleRangeScheduler::getNrBlocks(samples);
+	uint64_t nthRun = checkpointer.state.nthRun;
+	uint64_t firstBlock = checkpointer.state.nextBlock;
+	counters.restore(checkpointer.state.nrSamples, 0);
+
+	/*	Samples of every cell per run, within the blocks of the shard.	*/
+	const uint64_t shardFirstBlock = baseOptions.shard.getFirstBlock(nrCells * nrCellBlocks);
+	const uint64_t shardLastBlock = baseOptions.shard.getLastBlock(nrCells * nrCellBlocks);
+	std::vector<uint64_t> cellRunSamples(nrCells, 0), nrCellSamples(nrCells);
+	uint64_t runSamples = 0;
+	for (size_t cell = 0; cell < nrCells; cell++) {
+		const uint64_t cellFirstBlock = std::max(shardFirstBlock, cell * nrCellBlocks);
+		const uint64_t cellLastBlock = std::min(shardLastBlock, (cell + 1) * nrCellBlocks);
+		if (cellFirstBlock < cellLastBlock) {
+			cellRunSamples[cell] = SampleRangeScheduler::getRangeSamples(
+				cellFirstBlock - cell * nrCellBlocks, cellLastBlock - cell * nrCellBlocks, samples);
+		}
+		nrCellSamples[cell] = nthRun * cellRunSamples[cell];
+		runSamples += cellRunSamples[cell];
+	}
+	checkpointer.runStart = std::chrono::steady_clock::now();
+
+	/*	Collisions of every cell including the tasks of the current run.	*/
+	const auto getCellCollisions = [&] {
+		std::vector<uint64_t> nrCollisions = nrCellCollisions;
+		for (size_t cell = 0; cell < nrCells; cell++) {
+			for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+				for (size_t i = 0; i < nrCellCounters; i++) {
+					nrCollisions[cell * nrCellCounters + i] +=
+						taskCollisions[(cell * numTasks + nthTask) * nrCellCounters + i];
+				}
+			}
+		}
+		return nrCollisions;
+	};
+
+	do {
+		std::fill(taskCollisions.begin(), taskCollisions.end(), 0);
+		std::fill(taskCellTotals.begin(), taskCellTotals.end(), SampleTaskTotals());
+
+		SampleRangeScheduler ranges(nrCells * nrCellBlocks, numTasks, baseOptions.shard, firstBlock);
+		const uint64_t streamBase = nthRun * ranges.getNrBlocks();
+		firstBlock = 0;
+		runSampleTasks(
+			ranges, numTasks, counters,
+			[&](uint32_t nthTask, uint64_t block) {
+				const size_t cell = block / nrCellBlocks;
+				const uint64_t nrSamples = SampleRangeScheduler::getBlockSamples(block % nrCellBlocks, samples);
+				const auto blockStart = std::chrono::steady_clock::now();
+				sampleCollisionsNested(cellOptions[cell], sweep.nrBitErrors, sizeAlgorithms[cell / nrProbabilities],
+									   nrSamples, streamBase + block,
+									   &taskCollisions[(cell * numTasks + nthTask) * nrCellCounters]);
+
+				SampleTaskTotals &totals = taskCellTotals[cell * numTasks + nthTask];
+				totals.nrSamples += nrSamples;
+				totals.busySeconds +=
+					std::chrono::duration<double>(std::chrono::steady_clock::now() - blockStart).count();
+				return std::make_pair(nrSamples, static_cast<uint64_t>(0));
+			},
+			[&] {
+				const double wallTime = checkpointer.getWallTime();
+				ResultRecord progress = {"progress", "", 0, 0, 0, baseOptions.seed, 0, numTasks,
+										 counters.getTotalSamples(), 0, wallTime};
+				progress.targetSamples = (nthRun + 1) * runSamples;
+				writer.write(progress);
+				return false;
+			},
+			checkpointer.clock,
+			[&](uint64_t nextBlock) {
+				checkpointer.save(nthRun, nextBlock, counters.getTotalSamples(), getCellCollisions());
+			});
+		if (isTerminationRequested()) {
+			break;
+		}
+		nthRun++;
+
+		for (size_t cell = 0; cell < nrCells; cell++) {
+			const SampleOptions &options = cellOptions[cell];
+			for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+				const SampleTaskTotals &totals = taskCellTotals[cell * numTasks + nthTask];
+				const uint64_t *nrCollisions = &taskCollisions[(cell * numTasks + nthTask) * nrCellCounters];
+				for (size_t i = 0; i < nrCellCounters; i++) {
+					nrCellCollisions[cell * nrCellCounters + i] += nrCollisions[i];
+				}
+				if (totals.nrSamples == 0) {
+					continue;
+				}
+				for (size_t a = 0; a < nrAlgorithms; a++) {
+					for (size_t c = 0; c < nrCounts; c++) {
+						writer.write({"task", crcNames[a], options.dataSize * sizeof(CRCInt), sweep.nrBitErrors[c],
+									  options.probability, options.seed, nthTask, numTasks, totals.nrSamples,
+									  nrCollisions[a * nrCounts + c], totals.busySeconds});
+					}
+				}
+			}
+		}
+		for (size_t cell = 0; cell < nrCells; cell++) {
+			nrCellSamples[cell] += cellRunSamples[cell];
+		}
+		checkpointer.save(nthRun, 0, counters.getTotalSamples(), nrCellCollisions);
+		const double wallTime = checkpointer.getWallTime();
+
+		if (writer.getFormat() != ResultFormat::Text) {
+			for (size_t cell = 0; cell < nrCells; cell++) {
+				const SampleOptions &options = cellOptions[cell];
+				/*	Cells outside the shard have no samples.	*/
+				if (nrCellSamples[cell] == 0) {
+					continue;
+				}
+				for (size_t a = 0; a < nrAlgorithms; a++) {
+					for (size_t c = 0; c < nrCounts; c++) {
+						writer.write({"final", crcNames[a], options.dataSize * sizeof(CRCInt), sweep.nrBitErrors[c],
+									  options.probability, options.seed, 0, numTasks, nrCellSamples[cell],
+									  nrCellCollisions[cell * nrCellCounters + a * nrCounts + c], wallTime});
+					}
+				}
+			}
+			writeWorkerRecords(writer, counters, baseOptions.seed);
+			continue;
+		}
+
+		/*	The matrix is written directly, after the queued progress. Every row shows the samples of its own cells,
+		 *	the sizes of a block are counted separately.	*/
+		writer.flush();
+		FILE *file = writer.getFile();
+		fprintf(file, "\n");
+		for (size_t a = 0; a < nrAlgorithms; a++) {
+			for (size_t p = 0; p < nrProbabilities; p++) {
+				fprintf(file, "CRC: %s, error-probability %f\n", crcNames[a].c_str(), sweep.probabilities[p]);
+				fprintf(file, "%12s %14s", "size\\b", "samples");
+				for (const uint32_t nrBitError : sweep.nrBitErrors) {
+					fprintf(file, " %14u", nrBitError);
+				}
+				fprintf(file, "\n");
+				for (size_t s = 0; s < nrSizes; s++) {
+					const size_t cell = s * nrProbabilities + p;
+					fprintf(file, "%12u %14lu", (unsigned int)(cellOptions[cell].dataSize * sizeof(CRCInt)),
+							(unsigned long)nrCellSamples[cell]);
+					for (size_t c = 0; c < nrCounts; c++) {
+						const double _collisionPerc =
+							(double)nrCellCollisions[cell * nrCellCounters + a * nrCounts + c] /
+							(double)nrCellSamples[cell];
+						fprintf(file, " %14.6e", _collisionPerc);
+					}
+					fprintf(file, "\n");
+				}
+			}
+		}
+		fflush(file);
+	} while (runForever);
+}
+
+/**
+ * Estimate the undetected error rate of every algorithm with the importance sampler, one algorithm after the
+ * other on the bound marl scheduler. The messages do not take part, only the per-bit syndromes of the errors.
+ * Every algorithm samples the same random streams.
+ */
+static void runImportanceSampling(const std::vector<std::string> &crcNames, const SampleOptions &options,
+								  uint64_t samples, uint32_t numTasks, bool runForever, ResultsWriter &writer,
+								  ShardedCounters &counters) {
+	const size_t nrAlgorithms = crcNames.size();
+	const uint64_t messageSize = options.dataSize * sizeof(CRCInt);
+
+	/*	The samplers refer to the syndrome tables, allocated up front.	*/
+	std::vector<std::vector<uint64_t>> syndromes(nrAlgorithms);
+	std::vector<ImportanceSampler> samplers;
+	samplers.reserve(nrAlgorithms);
+	for (size_t a = 0; a < nrAlgorithms; a++) {
+		syndromes[a] = dispatchCRCAlgorithm(crcAlgorithmTable.at(crcNames[a]), [&](auto kernel) {
+			return createSyndromeTable<decltype(kernel)>(messageSize);
+		});
+		samplers.emplace_back(syndromes[a]);
+	}
+
+	std::vector<ImportanceSampleTotals> algorithmTotals(nrAlgorithms);
+	const auto runStart = std::chrono::steady_clock::now();
+
+	uint64_t nthRun = 0;
+	do {
+		for (size_t a = 0; a < nrAlgorithms; a++) {
+			/*	Every task accumulates into its own totals, merged once all the tasks completed.	*/
+			std::vector<ImportanceSampleTotals> importanceTotals(numTasks);
+
+			SampleRangeScheduler ranges(SampleRangeScheduler::getNrBlocks(samples), numTasks);
+			const uint64_t streamBase = nthRun * ranges.getNrBlocks();
+
+			const std::vector<SampleTaskTotals> taskTotals = runSampleTasks(
+				ranges, numTasks, counters,
+				[&](uint32_t nthTask, uint64_t block) {
+					const uint64_t nrSamples = SampleRangeScheduler::getBlockSamples(block, samples);
+					ImportanceSampleTotals &totals = importanceTotals[nthTask];
+					const uint64_t nrHits = totals.nrHits;
+					PCGRandom randGen(options.seed, streamBase + block);
+					samplers[a].sample(options.nrBitError, nrSamples, randGen, totals);
+					return std::make_pair(nrSamples, totals.nrHits - nrHits);
+				},
+				[&] {
+					const double wallTime =
+						std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+					ResultRecord progress = {"progress", "", 0, 0, 0, options.seed, 0, numTasks,
+											 counters.getTotalSamples(), 0, wallTime};
+					progress.targetSamples = (nthRun * nrAlgorithms + a + 1) * samples;
+					writer.write(progress);
+					return false;
+				});
+
+			for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+				algorithmTotals[a].merge(importanceTotals[nthTask]);
+				writer.write({"task", crcNames[a], messageSize, options.nrBitError, options.probability, options.seed,
+							  nthTask, numTasks, taskTotals[nthTask].nrSamples, importanceTotals[nthTask].nrHits,
+							  taskTotals[nthTask].busySeconds});
+			}
+
+			const ImportanceSampleTotals &totals = algorithmTotals[a];
+			const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+			ResultRecord estimate = {"importance", crcNames[a], messageSize, options.nrBitError, options.probability,
+									 options.seed, 0, numTasks, totals.nrSamples, totals.nrHits, wallTime};
+			estimate.estimate = totals.getEstimate();
+			estimate.standardError = totals.getStandardError();
+			estimate.effectiveSamples = totals.getEffectiveSampleSize();
+			writer.write(estimate);
+		}
+		nthRun++;
+		writeWorkerRecords(writer, counters, options.seed);
+	} while (runForever);
+}
+
+/**
+ * Outcomes of correcting the sampled errors, every sample has one. Samples whose flips of the same bits all
+ * cancelled out carry no error and are counted apart.
+ */
+struct CorrectionTotals {
+	uint64_t nrCorrected = 0;
+	uint64_t nrMiscorrected = 0;
+	uint64_t nrUncorrectable = 0;
+	uint64_t nrUndetected = 0;
+	uint64_t nrErrorFree = 0;
+
+	void merge(const CorrectionTotals &other) noexcept {
+		nrCorrected += other.nrCorrected;
+		nrMiscorrected += other.nrMiscorrected;
+		nrUncorrectable += other.nrUncorrectable;
+		nrUndetected += other.nrUndetected;
+		nrErrorFree += other.nrErrorFree;
+	}
+};
+
+/**
+ * Sample random errors and correct every detected one with the syndrome of the received message, draws the same
+ * errors as sampleCollisions for the same stream id. The syndrome is computed from the per-bit syndromes when
+ * incremental, otherwise by rehashing a random message with the error. A correction is only right when it flips
+ * exactly the bits in error, any other restores a message that was not sent.
+ */
+template <typename Kernel>
+static void sampleCorrection(const SampleOptions &options, const std::vector<uint64_t> &syndromes,
+							 const SyndromeCorrectionTable &correctionTable, uint64_t nrSamples, uint64_t streamId,
+							 CorrectionTotals &totals) {
+	std::vector<CRCInt> originalMsg(options.incremental ? 0 : options.dataSize);
+	std::vector<uint32_t> bitIndices;
+	const uint32_t dataBitSize = options.dataSize * sizeof(CRCInt) * 8;
+	PCGBatchRandom randGen(options.seed, streamId);
+	PCGRandom bitRandGen(options.seed, streamId);
+
+	for (uint64_t i = 0; i < nrSamples; i++) {
+		bitIndices.clear();
+		const unsigned int nrFlipped = generateErrorIndices(options, dataBitSize, bitRandGen, bitIndices);
+
+		/*	The bits in error ascending, flips of the same bit cancel.	*/
+		std::sort(bitIndices.begin(), bitIndices.end());
+		unsigned int nrErrorBits = 0;
+		for (unsigned int k = 0; k < nrFlipped; k++) {
+			if (nrErrorBits > 0 && bitIndices[nrErrorBits - 1] == bitIndices[k]) {
+				nrErrorBits--;
+			} else {
+				bitIndices[nrErrorBits++] = bitIndices[k];
+			}
+		}
+		if (nrErrorBits == 0) {
+			totals.nrErrorFree++;
+			continue;
+		}
+
+		uint64_t syndrome;
+		if (options.incremental) {
+			syndrome = computeErrorSyndrome(syndromes, bitIndices.data(), nrErrorBits);
+		} else {
+			generateRandomMessage(originalMsg, options.dataSize, randGen);
+			const uint64_t originalMsgCRC = computeCRC<Kernel>(originalMsg);
+			flipBitErrors(originalMsg, bitIndices.data(), nrErrorBits);
+			syndrome = originalMsgCRC ^ computeCRC<Kernel>(originalMsg);
+		}
+
+		uint32_t positions[correctionMaxBits];
+		if (syndrome == 0) {
+			totals.nrUndetected++;
+		} else if (const unsigned int nrCorrectedBits = correctionTable.find(syndrome, positions)) {
+			if (nrCorrectedBits == nrErrorBits &&
+				std::equal(positions, positions + nrCorrectedBits, bitIndices.data())) {
+				totals.nrCorrected++;
+			} else {
+				totals.nrMiscorrected++;
+			}
+		} else {
+			totals.nrUncorrectable++;
+		}
+	}
+}
+
+/**
+ * Correct the sampled errors of every algorithm with a syndrome table of the errors up to maxCorrectedBits bits,
+ * one algorithm after the other on the bound marl scheduler. The table of an algorithm only lives while it is
+ * sampled, as the one of bit pairs grows with the square of the message bits. Every algorithm samples the same
+ * random streams.
+ */
+static void runErrorCorrection(const std::vector<std::string> &crcNames, const SampleOptions &options,
+							   unsigned int maxCorrectedBits, uint64_t samples, uint32_t numTasks, bool runForever,
+							   ResultsWriter &writer, ShardedCounters &counters) {
+	const size_t nrAlgorithms = crcNames.size();
+	const uint64_t messageSize = options.dataSize * sizeof(CRCInt);
+
+	/*	Records of the channel carry its bit error rate, records of bursts their burst length.	*/
+	const bool isBitErrorCount = options.errorModel == ErrorModel::Trials || options.errorModel == ErrorModel::Distinct;
+	const uint32_t nrBitError = isBitErrorCount ? options.nrBitError : 0;
+	const float probability = options.errorModel == ErrorModel::Channel
+								  ? static_cast<float>(-std::expm1(options.logNoError))
+								  : options.probability;
+
+	const uint64_t shardSamples = SampleRangeScheduler::getShardSamples(options.shard, samples);
+
+	/*	The table is built from the syndromes even when the errors are rehashed.	*/
+	SampleOptions syndromeOptions = options;
+	syndromeOptions.incremental = true;
+
+	std::vector<CorrectionTotals> algorithmTotals(nrAlgorithms);
+	const auto runStart = std::chrono::steady_clock::now();
+
+	uint64_t nthRun = 0;
+	do {
+		for (size_t a = 0; a < nrAlgorithms; a++) {
+			dispatchCRCAlgorithm(crcAlgorithmTable.at(crcNames[a]), [&](auto kernel) {
+				using Kernel = decltype(kernel);
+
+				const std::vector<uint64_t> syndromes = createSampleSyndromeTable<Kernel>(syndromeOptions);
+				const SyndromeCorrectionTable correctionTable(syndromes, maxCorrectedBits);
+
+				/*	Every task accumulates into its own totals, merged once all the tasks completed.	*/
+				std::vector<CorrectionTotals> correctionTotals(numTasks);
+
+				SampleRangeScheduler ranges(SampleRangeScheduler::getNrBlocks(samples), numTasks, options.shard);
+				const uint64_t streamBase = nthRun * ranges.getNrBlocks();
+
+				const std::vector<SampleTaskTotals> taskTotals = runSampleTasks(
+					ranges, numTasks, counters,
+					[&](uint32_t nthTask, uint64_t block) {
+						const uint64_t nrSamples = SampleRangeScheduler::getBlockSamples(block, samples);
+						CorrectionTotals &totals = correctionTotals[nthTask];
+						const uint64_t nrUndetected = totals.nrUndetected;
+						sampleCorrection<Kernel>(options, syndromes, correctionTable, nrSamples, streamBase + block,
+												 totals);
+						return std::make_pair(nrSamples, totals.nrUndetected - nrUndetected);
+					},
+					[&] {
+						const double wallTime =
+							std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+						ResultRecord progress = {"progress", "", 0, 0, 0, options.seed, 0, numTasks,
+												 counters.getTotalSamples(), 0, wallTime};
+						progress.targetSamples = (nthRun * nrAlgorithms + a + 1) * shardSamples;
+						writer.write(progress);
+						return false;
+					});
+
+				for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+					algorithmTotals[a].merge(correctionTotals[nthTask]);
+					ResultRecord task = {"task", crcNames[a], messageSize, nrBitError, probability, options.seed,
+										 nthTask, numTasks, taskTotals[nthTask].nrSamples,
+										 correctionTotals[nthTask].nrUndetected, taskTotals[nthTask].busySeconds};
+					task.burstLength = options.burstLength;
+					writer.write(task);
+				}
+
+				const CorrectionTotals &totals = algorithmTotals[a];
+				const double wallTime =
+					std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+				ResultRecord correction = {"correction", crcNames[a], messageSize, nrBitError, probability,
+										   options.seed, 0, numTasks, (nthRun + 1) * shardSamples, totals.nrUndetected,
+										   wallTime};
+				correction.burstLength = options.burstLength;
+				correction.nrCorrected = totals.nrCorrected;
+				correction.nrMiscorrected = totals.nrMiscorrected;
+				correction.nrUncorrectable = totals.nrUncorrectable;
+				correction.nrErrorFree = totals.nrErrorFree;
+				writer.write(correction);
+			});
+		}
+		nthRun++;
+		writeWorkerRecords(writer, counters, options.seed);
+	} while (runForever);
+}
+
+/*	Number of candidate polynomials per block of the search.	*/
+static constexpr uint64_t searchBlockSize = 64;
+
+/**
+ * Scan the candidate polynomials of the search on the bound marl scheduler, keeping the best ones. The blocks
+ * of candidates are claimed dynamically. With a checkpoint path, the progress is written at every checkpoint
+ * interval, at the end and when asked to terminate, and a search with a matching checkpoint continues from it.
+ */
+static void runSearch(const SearchSpec &spec, const std::string &checkpointPath, uint32_t numTasks,
+					  ResultsWriter &writer, ShardedCounters &counters) {
+	const std::string specStr = formatSearchSpec(spec);
+	const uint64_t nrCandidates = spec.getNrCandidates();
+	SearchTopPolynomials top(spec.nrTop);
+
+	uint64_t nextCandidate = 0;
+	if (!checkpointPath.empty()) {
+		std::vector<PolynomialScore> scores;
+		if (readSearchCheckpoint(checkpointPath, specStr, nextCandidate, scores)) {
+			for (const PolynomialScore &score : scores) {
+				top.insert(score);
+			}
+		}
+	}
+
+	/*	Checkpoints hold the candidates before the first block not completed yet.	*/
+	const uint64_t firstBlock = std::min(nextCandidate, nrCandidates) / searchBlockSize;
+	const uint64_t nrBlocks = (nrCandidates + searchBlockSize - 1) / searchBlockSize - firstBlock;
+	std::unique_ptr<std::atomic_bool[]> blockDone(new std::atomic_bool[nrBlocks]);
+	for (uint64_t i = 0; i < nrBlocks; i++) {
+		blockDone[i].store(false, std::memory_order_relaxed);
+	}
+	uint64_t nrDoneBlocks = 0;
+
+	const auto writeCheckpoint = [&] {
+		while (nrDoneBlocks < nrBlocks && blockDone[nrDoneBlocks].load(std::memory_order_acquire)) {
+			nrDoneBlocks++;
+		}
+		const uint64_t next = std::min(nrCandidates, (firstBlock + nrDoneBlocks) * searchBlockSize);
+		if (!writeSearchCheckpoint(checkpointPath, specStr, next, top.getScores())) {
+			std::cerr << "Failed to write the checkpoint " << checkpointPath << std::endl;
+		}
+	};
+
+	const auto runStart = std::chrono::steady_clock::now();
+	CheckpointClock clock(!checkpointPath.empty());
+	SampleRangeScheduler ranges(nrBlocks, numTasks);
+	runSampleTasks(
+		ranges, numTasks, counters,
+		[&](uint32_t, uint64_t block) {
+			const uint64_t first = (firstBlock + block) * searchBlockSize;
+			const uint64_t last = std::min(nrCandidates, first + searchBlockSize);
+
+			/*	Candidates that can not rank before the worst kept one are dropped early.	*/
+			PolynomialScore bound, score;
+			const bool hasBound = top.getBound(bound);
+			for (uint64_t i = first; i < last; i++) {
+				const uint64_t polynomial = spec.getCandidate(i);
+				if (spec.isSelected(polynomial) &&
+					evaluatePolynomial(spec, polynomial, hasBound ? &bound : nullptr, score)) {
+					top.insert(score);
+				}
+			}
+			blockDone[block].store(true, std::memory_order_release);
+			return std::make_pair(last - first, static_cast<uint64_t>(0));
+		},
+		[&] {
+			const auto now = std::chrono::steady_clock::now();
+			ResultRecord progress = {"progress", "", 0, 0, 0, 0, 0, numTasks, counters.getTotalSamples(), 0,
+									 std::chrono::duration<double>(now - runStart).count()};
+			progress.targetSamples = nrCandidates - firstBlock * searchBlockSize;
+			writer.write(progress);
+
+			if (clock.isDue()) {
+				writeCheckpoint();
+				clock.restart();
+			}
+			return isTerminationRequested();
+		});
+	if (!checkpointPath.empty()) {
+		writeCheckpoint();
+	}
+	if (isTerminationRequested()) {
+		return;
+	}
+
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+	const std::vector<PolynomialScore> scores = top.getScores();
+	for (uint32_t rank = 0; rank < scores.size(); rank++) {
+		char polynomial[32];
+		snprintf(polynomial, sizeof(polynomial), "0x%0*" PRIx64, static_cast<int>((spec.width + 3) / 4),
+				 scores[rank].polynomial);
+		for (size_t i = 0; i < spec.messageSizes.size(); i++) {
+			writer.write({"search", polynomial, spec.messageSizes[i], scores[rank].hammingDistances[i], 1.0f, 0, rank,
+						  static_cast<uint32_t>(scores.size()), 0, scores[rank].nrUndetected[i], wallTime});
+		}
+	}
+}
 
-template <typename T> static bool isArrayEqual(const std::vector<T> &in, const std::vector<T> &out) {
-	assert(in.size() == out.size());
+/**
+ * Parse a comma separated list of algorithm names, or all for every algorithm.
+ */
+static bool parseCRCAlgorithmList(const std::string &list, std::vector<std::string> &names) {
+	if (list == "all") {
+		for (const auto &entry : crcAlgorithmTable) {
+			if (entry.first != customCRCName) {
+				names.push_back(entry.first);
+			}
+		}
+		std::sort(names.begin(), names.end());
+		return true;
+	}
 
-	for (size_t i = 0; i < in.size(); i++) {
-		if (in[i] != out[i])
+	size_t begin = 0;
+	while (begin <= list.size()) {
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos) {
+			end = list.size();
+		}
+		const std::string name = list.substr(begin, end - begin);
+		if (crcAlgorithmTable.find(name) == crcAlgorithmTable.end()) {
+			std::cerr << "Invalid CRC Options " << name << std::endl;
 			return false;
+		}
+		if (std::find(names.begin(), names.end(), name) == names.end()) {
+			names.push_back(name);
+		}
+		begin = end + 1;
 	}
 	return true;
 }
 
-typedef uint32_t CRCInt;
+/**
+ * Cross-check every supported implementation of every algorithm against the CRCpp reference.
+ */
+static bool runSelfTest() {
+	static const size_t messageSizes[] = {4,  5,  6,  7,	 8,	  9,   15,	16,	 17,  31,  32,	 33,
+										  63, 64, 65, 127, 128, 129, 191, 255, 256, 257, 1000, 4099};
+
+	std::vector<std::string> names;
+	for (const auto &entry : crcAlgorithmTable) {
+		if (entry.first != customCRCName) {
+			names.push_back(entry.first);
+		}
+	}
+	std::sort(names.begin(), names.end());
+
+	PCGRandom randGen(std::random_device{}(), 0);
+	bool passed = true;
+
+	for (const std::string &name : names) {
+		const CRCAlgorithm algorithm = crcAlgorithmTable.at(name);
+
+		dispatchCRCAlgorithm(algorithm, [&](auto kernel) {
+			using Kernel = decltype(kernel);
+			const CRCImplementation previous = Kernel::implementation;
+
+			std::cout << name << ":";
+			for (const CRCImplementation implementation : allCRCImplementations) {
+				if (!Kernel::isImplementationSupported(implementation)) {
+					continue;
+				}
+				Kernel::setImplementation(implementation);
+
+				unsigned int nrFailed = 0;
+				for (const size_t messageSize : messageSizes) {
+					std::vector<uint8_t> message(messageSize);
+					for (uint8_t &value : message) {
+						value = static_cast<uint8_t>(randGen.getRandom());
+					}
+					const uint64_t reference = computeReferenceCRC(algorithm, message);
+					if (Kernel::compute(message.data(), message.size()) != reference) {
+						nrFailed++;
+					}
+					/*	The same message split into chunks of one and of several words, joined with the combine.	*/
+					for (const uint64_t chunkSize : {8, 64}) {
+						if (ChunkedCRC::create<Kernel>(messageSize, chunkSize).compute(message.data()) != reference) {
+							nrFailed++;
+						}
+					}
+				}
+
+				std::cout << " " << getCRCImplementationName(implementation) << (nrFailed == 0 ? " ok" : " FAILED");
+				passed &= nrFailed == 0;
+			}
+
+			/*	The sparse syndromes of every bit against the syndrome table.	*/
+			unsigned int nrFailed = 0;
+			for (const size_t messageSize : messageSizes) {
+				const std::vector<uint64_t> table = createSyndromeTable<Kernel>(messageSize);
+				const SparseSyndromes sparse = SparseSyndromes::create<Kernel>(messageSize);
+				for (size_t bit = 0; bit < table.size(); bit++) {
+					nrFailed += sparse.getSyndrome(bit) != table[bit];
+				}
+			}
+			std::cout << " sparse-syndromes" << (nrFailed == 0 ? " ok" : " FAILED") << std::endl;
+			passed &= nrFailed == 0;
+
+			Kernel::setImplementation(previous);
+		});
+	}
+
+	return passed;
+}
+
+/**
+ * Merge the results of the shards of a run, the csv or jsonl output of processes run with the same --seed and a
+ * --shard each. The final and correction records of every algorithm and error parameters are summed over the
+ * files, taking the last of each file so that a shard run with --forever contributes its latest totals. Shards
+ * of distinct seeds are independent samples and add up as well, a shard given twice is rejected.
+ */
+static int runMerge(int argc, const char **argv) {
+	cxxopts::Options options("CRCAnalysis merge", "Merge the results of the shards of a run");
+	options.add_options()("h,help", "helper information.")(
+		"o,output", "Write the merged results to a file instead of stdout.",
+		cxxopts::value<std::string>()->default_value(""))(
+		"output-format", "Format of the merged results (text, csv, jsonl).",
+		cxxopts::value<std::string>()->default_value("text"))(
+		"confidence", "Confidence level of the intervals.", cxxopts::value<double>()->default_value("0.95"))(
+		"files", "Results of the shards.", cxxopts::value<std::vector<std::string>>());
+	options.parse_positional({"files"});
+	options.positional_help("<results>...");
+	auto result = options.parse(argc, (char **&)argv);
+
+	if (result.count("help") > 0) {
+		std::cout << options.help();
+		return EXIT_SUCCESS;
+	}
+	if (result.count("files") == 0) {
+		std::cerr << "Merge requires the results of the shards" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const double confidence = result["confidence"].as<double>();
+	if (!(confidence > 0 && confidence < 1)) {
+		std::cerr << "Confidence must be within (0, 1)" << std::endl;
+		return EXIT_FAILURE;
+	}
+	ResultFormat resultFormat;
+	const std::string &resultFormatStr = result["output-format"].as<std::string>();
+	if (!parseResultFormat(resultFormatStr, resultFormat)) {
+		std::cerr << "Invalid output format " << resultFormatStr << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	/*	Records of the same algorithm and errors, kept in the order they first appear.	*/
+	using RecordKey = std::tuple<std::string, std::string, uint64_t, uint32_t, float, uint32_t>;
+	const auto getRecordKey = [](const ResultRecord &record) {
+		return RecordKey(record.type, record.algorithm, record.messageSize, record.nrBitError, record.probability,
+						 record.burstLength);
+	};
+	std::vector<ResultRecord> merged;
+	std::map<RecordKey, size_t> mergedIndices;
+	std::vector<std::set<std::tuple<uint64_t, uint32_t, uint32_t>>> mergedShards;
+	std::map<std::pair<uint64_t, uint32_t>, std::set<uint32_t>> seedShards;
+
+	for (const std::string &path : result["files"].as<std::vector<std::string>>()) {
+		std::vector<ResultRecord> records;
+		if (!readResultRecords(path, records)) {
+			std::cerr << "Failed to open " << path << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::vector<ResultRecord> latest;
+		std::map<RecordKey, size_t> latestIndices;
+		for (const ResultRecord &record : records) {
+			if (record.type != "final" && record.type != "correction") {
+				continue;
+			}
+			const auto inserted = latestIndices.emplace(getRecordKey(record), latest.size());
+			if (inserted.second) {
+				latest.push_back(record);
+			} else {
+				latest[inserted.first->second] = record;
+			}
+		}
+
+		for (const ResultRecord &record : latest) {
+			if (record.nrShards < 1 || record.shard >= record.nrShards) {
+				throw std::invalid_argument("Invalid shard in " + path);
+			}
+			const auto inserted = mergedIndices.emplace(getRecordKey(record), merged.size());
+			if (inserted.second) {
+				merged.push_back(record);
+				mergedShards.emplace_back();
+			} else {
+				ResultRecord &total = merged[inserted.first->second];
+				total.seed = total.seed == record.seed ? total.seed : 0;
+				total.nrTasks += record.nrTasks;
+				total.samples += record.samples;
+				total.collisions += record.collisions;
+				total.wallTime = std::max(total.wallTime, record.wallTime);
+				total.nrCorrected += record.nrCorrected;
+				total.nrMiscorrected += record.nrMiscorrected;
+				total.nrUncorrectable += record.nrUncorrectable;
+				total.nrErrorFree += record.nrErrorFree;
+			}
+			if (!mergedShards[inserted.first->second]
+					 .emplace(record.seed, record.shard, record.nrShards)
+					 .second) {
+				std::cerr << path << " repeats the shard " << record.shard << "/" << record.nrShards << " of the seed "
+						  << record.seed << " for " << record.algorithm << std::endl;
+				return EXIT_FAILURE;
+			}
+			seedShards[{record.seed, record.nrShards}].insert(record.shard);
+		}
+	}
+
+	if (merged.empty()) {
+		std::cerr << "No final or correction records to merge" << std::endl;
+		return EXIT_FAILURE;
+	}
+	/*	A missing shard leaves fewer samples, the merged rates are still unbiased.	*/
+	for (const auto &shards : seedShards) {
+		if (shards.second.size() < shards.first.second) {
+			std::cerr << "Missing " << shards.first.second - shards.second.size() << " of the " << shards.first.second
+					  << " shards of the seed " << shards.first.first << std::endl;
+		}
+	}
+
+	const std::string &outputPath = result["output"].as<std::string>();
+	FILE *outputFile = stdout;
+	if (!outputPath.empty()) {
+		outputFile = fopen(outputPath.c_str(), "w");
+		if (outputFile == nullptr) {
+			std::cerr << "Failed to open " << outputPath << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	defer(if (outputFile != stdout) fclose(outputFile));
+	ResultsWriter writer(resultFormat, outputFile, computeNormalQuantile(confidence));
+	for (const ResultRecord &record : merged) {
+		writer.write(record);
+	}
+	return EXIT_SUCCESS;
+}
 
 int main(int argc, const char **argv) {
 
 	/*	*/
 	try {
+		if (argc > 1 && strcmp(argv[1], "merge") == 0) {
+			return runMerge(argc - 1, argv + 1);
+		}
+
 		uint64_t samples;
-		uint32_t dataSize;
+		uint64_t dataSize;
 		uint32_t nrChunk;
 		uint32_t nrBitError;
 		float probablity;
-		std::atomic_uint64_t nrCollision = 0;
-		std::atomic_uint64_t nrOfSamples = 0;
-		std::atomic_uint32_t nrTaskCompleted = 0;
 		CRCAlgorithm crcAlgorithm;
 
 		const std::string helperInfo = "Naive CRC Analysis\n"
@@ -501,17 +1819,98 @@ int main(int argc, const char **argv) {
 
 		cxxopts::Options options("CRCAnalysis", helperInfo);
 		options.add_options()("v,version", "Version information")("h,help", "helper information.")(
-			"c,crc", "CRC Algorithm", cxxopts::value<std::string>()->default_value("crc8"))(
-			"p,message-data-size", "Size of each messages in bytes.", cxxopts::value<uint32_t>()->default_value("5"))(
-			"e,error-correction", "Perform Error Correction.", cxxopts::value<bool>()->default_value("false"))(
+			"c,crc", "CRC Algorithm, a comma separated list or all to evaluate several on the same samples.",
+			cxxopts::value<std::string>()->default_value("crc8"))(
+			"p,message-data-size", "Size of each messages in bytes, a multiple of 4.",
+			cxxopts::value<uint64_t>()->default_value("4"))(
+			"e,error-correction",
+			"Correct the detected errors of up to this many bits (1 or 2) with a syndrome table and report the "
+			"corrected, miscorrected and uncorrectable rates (0 disabled).",
+			cxxopts::value<uint32_t>()->default_value("0")->implicit_value("1"))(
 			"s,samples", "Samples", cxxopts::value<uint64_t>()->default_value("1000000"))(
-			"t,tasks", "Task", cxxopts::value<int>()->default_value("2000"))(
+			"t,tasks", "Number of concurrent sampling tasks, one per worker thread by default.", cxxopts::value<int>())(
+			"threads", "Number of worker threads, all cores by default.", cxxopts::value<uint32_t>()->default_value("0"))(
 			"b,nr-of-error-bits", "Number of bits error added to each message.",
 			cxxopts::value<int>()->default_value("1"))("f,forever", "Run it forever.",
 													   cxxopts::value<bool>()->default_value("false"))(
 			"l,show-crc-list", "List of support CRC and Checksum Alg", cxxopts::value<bool>()->default_value("false"))(
 			"P,error-probability", "Probability of adding error in data package.",
-			cxxopts::value<float>()->default_value("1"));
+			cxxopts::value<float>()->default_value("1"))(
+			"i,incremental", "Compute the error message CRC from per-bit syndromes instead of rehashing it.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"x,exhaustive", "Count the undetected error patterns exactly for every bit error weight up to 4.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"k,kernel", "Force the CRC kernel implementation (bytewise, slicing-by-8, slicing-by-16, pclmul, sse4.2).",
+			cxxopts::value<std::string>()->default_value(""))(
+			"self-test",
+			"Cross-check every CRC kernel implementation and the chunk combine against CRCpp, and the sparse "
+			"syndromes against the syndrome table.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"B,batch", "Number of messages generated and hashed interleaved per batch, multiple of 8 (0 disabled).",
+			cxxopts::value<uint32_t>()->default_value("0"))(
+			"sweep", "Run a grid of parameters in one process, e.g. b=1..8,size=4..4096:x2,P=0.25..1:x2.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"seed", "Seed of the random generators, random if not set. Runs with the same seed are reproducible.",
+			cxxopts::value<uint64_t>())(
+			"target-relative-error",
+			"Stop sampling once the confidence interval is within this relative error of the collision rate, "
+			"--samples is then the upper bound (0 disabled).",
+			cxxopts::value<double>()->default_value("0"))(
+			"confidence", "Confidence level of the intervals.", cxxopts::value<double>()->default_value("0.95"))(
+			"o,output", "Write the results to a file instead of stdout.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"output-format", "Format of the results (text, csv, jsonl).",
+			cxxopts::value<std::string>()->default_value("text"))(
+			"importance",
+			"Estimate the undetected error rate with importance sampling on the per-bit syndromes, for rates too "
+			"small to observe.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"analytic",
+			"Compute the exact undetected error probabilities from the dual code, for CRCs up to 24 bits. "
+			"Followed by a sampling run when --samples is set.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"ber",
+			"Bit error rate of a channel flipping every bit independently, sampled instead of the bit error count "
+			"and computed by the analytic mode (0 disabled).",
+			cxxopts::value<double>()->default_value("0"))(
+			"distinct", "Flip distinct bits, for errors of exactly the number of bit errors.",
+			cxxopts::value<bool>()->default_value("false"))(
+			"burst-length",
+			"Sample burst errors of this length instead of bit errors, or count every burst up to it with "
+			"--exhaustive (0 disabled).",
+			cxxopts::value<uint32_t>()->default_value("0"))(
+			"poly", "Polynomial of a custom CRC in the normal form, evaluated as the custom algorithm.",
+			cxxopts::value<std::string>())("width", "Width of the custom CRC in bits.", cxxopts::value<uint32_t>())(
+			"init", "Initial value of the custom CRC.", cxxopts::value<std::string>()->default_value("0"))(
+			"refin", "Reflect the input bytes of the custom CRC.", cxxopts::value<bool>()->default_value("false"))(
+			"refout", "Reflect the output of the custom CRC.", cxxopts::value<bool>()->default_value("false"))(
+			"xorout", "Final XOR of the custom CRC.", cxxopts::value<std::string>()->default_value("0"))(
+			"search",
+			"Rank every polynomial of a width by its Hamming distance, e.g. width=16,size=8..1024:x4,top=10 with "
+			"optional poly=first..last and parity=1.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"checkpoint",
+			"File the progress of a search or sampling run is written to, periodically and on SIGTERM. A search "
+			"continues from it if it exists.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"resume", "Continue the run saved in this checkpoint, and keep saving it there unless --checkpoint is set.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"shard",
+			"Sample only the shard i/N of every run, numbered from 0, for splitting a seeded run across processes. "
+			"The results are combined with the merge command.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"profile",
+			"Time the phases of one in this many samples and print the time per sample of every phase and the load "
+			"of every worker at exit (0 disabled).",
+			cxxopts::value<uint32_t>()->default_value("0")->implicit_value("64"))(
+			"corpus",
+			"Sample the messages from this file, or the files of this directory, sliced into messages of the "
+			"message size instead of random messages.",
+			cxxopts::value<std::string>()->default_value(""))(
+			"chunk-size",
+			"Split messages larger than this many bytes into chunks hashed in parallel and joined with a CRC "
+			"combine, a multiple of 8 (0 to hash every message serially).",
+			cxxopts::value<uint64_t>()->default_value(std::to_string(defaultCRCChunkSize)));
 
 		auto result = options.parse(argc, (char **&)argv);
 
@@ -520,104 +1919,794 @@ int main(int argc, const char **argv) {
 			std::cout << options.help();
 			return EXIT_SUCCESS;
 		}
-		if (result.count("version") > 0) {
-			std::cout << "Version: " << CRC_ANALYSIS_STR << " hash: " << CRC_ANALYSIS_GITCOMMIT_STR
-					  << " branch: " << CRC_ANALYSIS_GITBRANCH_TR << std::endl;
-			return EXIT_SUCCESS;
-		}
 		if (result.count("show-crc-list") > 0) {
-			auto bit = table.begin();
-			for (; bit != table.end(); bit++) {
-				std::cout << (*bit).first << std::endl;
+			auto bit = crcAlgorithmTable.begin();
+			for (; bit != crcAlgorithmTable.end(); bit++) {
+				if ((*bit).first != customCRCName) {
+					std::cout << (*bit).first << std::endl;
+				}
 			}
 			return EXIT_SUCCESS;
 		}
+		if (result.count("self-test") > 0) {
+			return runSelfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
 
 		/*	*/
-		dataSize = result["message-data-size"].as<uint32_t>() / sizeof(CRCInt);
+		dataSize = result["message-data-size"].as<uint64_t>() / sizeof(CRCInt);
 		samples = result["samples"].as<uint64_t>();
-		nrChunk = result["tasks"].as<int>();
+		nrChunk = result.count("tasks") > 0 ? result["tasks"].as<int>() : 0;
+		const uint32_t nrThreads = result["threads"].as<uint32_t>();
 		nrBitError = result["nr-of-error-bits"].as<int>();
 		probablity = result["error-probability"].as<float>();
 		const bool runForever = result["forever"].as<bool>();
+		const uint32_t burstLength = result["burst-length"].as<uint32_t>();
+		/*	Bursts are laid out in the transmitted bit order of each algorithm, through its syndromes.	*/
+		const bool runIncremental = result["incremental"].as<bool>() || burstLength > 0;
+		const bool runExhaustive = result["exhaustive"].as<bool>();
+		const uint32_t batchLanes = result["batch"].as<uint32_t>();
+		const double targetRelativeError = result["target-relative-error"].as<double>();
+		const double confidence = result["confidence"].as<double>();
+		const bool runImportance = result["importance"].as<bool>();
+		const bool runAnalytic = result["analytic"].as<bool>();
+		const double bitErrorRate = result["ber"].as<double>();
+		const bool runDistinct = result["distinct"].as<bool>();
+
+		if (!(confidence > 0 && confidence < 1) || targetRelativeError < 0) {
+			std::cerr << "Confidence must be within (0, 1) and the target relative error positive" << std::endl;
+			return EXIT_FAILURE;
+		}
+		const double z = computeNormalQuantile(confidence);
+
+		if (batchLanes % batchLaneGroup != 0 || batchLanes > batchMaxLanes) {
+			std::cerr << "Batch size must be a multiple of " << batchLaneGroup << " up to " << batchMaxLanes << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	A resumed run keeps saving to its checkpoint, and continues with its seed.	*/
+		const std::string &resumePath = result["resume"].as<std::string>();
+		SampleCheckpointer checkpointer;
+		checkpointer.path = result["checkpoint"].as<std::string>();
+		if (checkpointer.path.empty()) {
+			checkpointer.path = resumePath;
+		}
+		const bool isSearch = !result["search"].as<std::string>().empty();
+		if (!resumePath.empty() && !isSearch && !readSampleCheckpoint(resumePath, checkpointer.state)) {
+			std::cerr << "Failed to open the checkpoint " << resumePath << std::endl;
+			return EXIT_FAILURE;
+		}
+		checkpointer.previousWallTime = checkpointer.state.wallTime;
+
+		uint64_t seed;
+		if (result.count("seed") > 0) {
+			seed = result["seed"].as<uint64_t>();
+		} else if (!resumePath.empty() && !isSearch) {
+			seed = checkpointer.state.seed;
+		} else {
+			std::random_device randomDevice;
+			seed = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+		}
+
+		if (bitErrorRate < 0 || bitErrorRate >= 1) {
+			std::cerr << "Bit error rate must be within [0, 1)" << std::endl;
+			return EXIT_FAILURE;
+		}
+		ErrorModel errorModel = runDistinct ? ErrorModel::Distinct : ErrorModel::Trials;
+		if (bitErrorRate > 0) {
+			errorModel = ErrorModel::Channel;
+		} else if (burstLength > 0) {
+			errorModel = ErrorModel::Burst;
+		}
+
+		/*	The shards of a run must share its seed, to sample disjoint blocks of the same random streams.	*/
+		SampleShard shard;
+		const std::string &shardStr = result["shard"].as<std::string>();
+		if (!shardStr.empty()) {
+			unsigned int index, count;
+			char end;
+			if (sscanf(shardStr.c_str(), "%u/%u%c", &index, &count, &end) != 2 || count < 1 || index >= count) {
+				std::cerr << "Invalid shard " << shardStr << ", expected i/N with 0 <= i < N" << std::endl;
+				return EXIT_FAILURE;
+			}
+			shard = SampleShard{index, count};
+			if (count > 1 && result.count("seed") == 0 && resumePath.empty()) {
+				std::cerr << "Shards require the --seed of the run" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		const uint64_t messageDataSize = result["message-data-size"].as<uint64_t>();
+		if (messageDataSize == 0 || messageDataSize % sizeof(CRCInt) != 0 || messageDataSize > maxMessageSize) {
+			std::cerr << "Message data size must be a multiple of " << sizeof(CRCInt) << " bytes of at most "
+					  << maxMessageSize << " bytes" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	The corpus is mapped for the whole run, the messages are read from it in place.	*/
+		std::unique_ptr<MessageCorpus> corpus;
+		const std::string &corpusPath = result["corpus"].as<std::string>();
+		if (!corpusPath.empty()) {
+			corpus.reset(new MessageCorpus(corpusPath, dataSize * sizeof(CRCInt)));
+		}
+		const uint64_t chunkSize = result["chunk-size"].as<uint64_t>();
+		if (chunkSize % 8 != 0) {
+			std::cerr << "Chunk size must be a multiple of 8 bytes" << std::endl;
+			return EXIT_FAILURE;
+		}
+		const SampleOptions sampleOptions = {dataSize, nrBitError, probablity, runIncremental, batchLanes, seed,
+											 errorModel, std::log1p(-bitErrorRate), burstLength, shard, corpus.get(),
+											 chunkSize};
+
+		/*	Dimensions missing from the sweep keep the values of their own options.	*/
+		SweepSpec sweep;
+		const std::string &sweepStr = result["sweep"].as<std::string>();
+		if (!sweepStr.empty()) {
+			sweep = parseSweepSpec(sweepStr);
+			if (sweep.nrBitErrors.empty()) {
+				sweep.nrBitErrors.push_back(nrBitError);
+			}
+			if (sweep.messageSizes.empty()) {
+				sweep.messageSizes.push_back(dataSize * sizeof(CRCInt));
+			}
+			if (sweep.probabilities.empty()) {
+				sweep.probabilities.push_back(probablity);
+			}
+			/*	Nested errors extend the smaller bit error counts.	*/
+			std::sort(sweep.nrBitErrors.begin(), sweep.nrBitErrors.end());
+			sweep.nrBitErrors.erase(std::unique(sweep.nrBitErrors.begin(), sweep.nrBitErrors.end()),
+									sweep.nrBitErrors.end());
+			for (const uint32_t messageSize : sweep.messageSizes) {
+				if (messageSize == 0 || messageSize % sizeof(CRCInt) != 0 || messageSize > maxMessageSize) {
+					std::cerr << "Sweep message sizes must be multiples of " << sizeof(CRCInt) << " bytes of at most "
+							  << maxMessageSize << " bytes" << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+			if (runExhaustive || batchLanes > 0 || targetRelativeError > 0) {
+				std::cerr << "Sweep does not support the exhaustive, batch or early stopping mode" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (runImportance) {
+			if (!sweepStr.empty() || runExhaustive || batchLanes > 0 || targetRelativeError > 0) {
+				std::cerr << "Importance sampling does not support the sweep, exhaustive, batch or early stopping mode"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (probablity < 1.0f || nrBitError < 1) {
+				std::cerr << "Importance sampling requires an error probability of 1 and at least one bit error"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		SearchSpec search;
+		const std::string &searchStr = result["search"].as<std::string>();
+		if (!searchStr.empty()) {
+			search = parseSearchSpec(searchStr);
+			if (search.messageSizes.empty()) {
+				search.messageSizes.push_back(dataSize * sizeof(CRCInt));
+			}
+			if (search.messageSizes.front() > searchMaxMessageSize) {
+				std::cerr << "Search supports messages up to " << searchMaxMessageSize << " bytes" << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (!sweepStr.empty() || runExhaustive || runImportance || runAnalytic) {
+				std::cerr << "Search does not support the sweep, exhaustive, importance or analytic mode" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		const uint32_t maxCorrectedBits = result["error-correction"].as<uint32_t>();
+		if (maxCorrectedBits > 0) {
+			if (maxCorrectedBits > correctionMaxBits) {
+				std::cerr << "Error correction supports 1 to " << correctionMaxBits << " bits" << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (maxCorrectedBits >= 2 && dataSize * sizeof(CRCInt) * 8 > correctionMaxPairMessageBits) {
+				std::cerr << "Correcting 2 bits supports messages up to " << correctionMaxPairMessageBits / 8
+						  << " bytes" << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (!sweepStr.empty() || !searchStr.empty() || runExhaustive || runImportance || runAnalytic ||
+				batchLanes > 0 || targetRelativeError > 0) {
+				std::cerr << "Error correction does not support the sweep, search, exhaustive, importance, analytic, "
+							 "batch or early stopping mode"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		/*	Corpus messages are sampled one at a time, at the message size.	*/
+		if (corpus && (!sweepStr.empty() || !searchStr.empty() || runExhaustive || runImportance || runAnalytic ||
+					   maxCorrectedBits > 0 || batchLanes > 0)) {
+			std::cerr << "Corpus does not support the sweep, search, exhaustive, importance, analytic, error "
+						 "correction or batch mode"
+					  << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	Only the sampled counts add up across the shards.	*/
+		if (shard.count > 1 && (!searchStr.empty() || runExhaustive || runImportance || runAnalytic ||
+								targetRelativeError > 0 || result["output-format"].as<std::string>() == "text")) {
+			std::cerr << "Shards do not support the search, exhaustive, importance, analytic, early stopping mode or "
+						 "the text output format"
+					  << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (runAnalytic && (!sweepStr.empty() || runExhaustive)) {
+			std::cerr << "Analytic mode does not support the sweep or exhaustive mode" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	The channel decides on its own how many bits flip, the importance sampler draws its own errors.	*/
+		if (errorModel == ErrorModel::Channel &&
+			(runDistinct || probablity < 1.0f || !sweepStr.empty() || runImportance || runExhaustive)) {
+			std::cerr << "Bit error rate does not support distinct errors, an error probability, the sweep, "
+						 "importance or exhaustive mode"
+					  << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (burstLength > 0) {
+			const uint32_t maxBurstLength = runExhaustive ? burstMaxExhaustiveLength : burstMaxLength;
+			if (bitErrorRate > 0 || runDistinct || probablity < 1.0f || !sweepStr.empty() || runImportance ||
+				runAnalytic) {
+				std::cerr << "Burst errors do not support a bit error rate, distinct errors, an error probability, the "
+							 "sweep, importance or analytic mode"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (burstLength > maxBurstLength || burstLength > dataSize * sizeof(CRCInt) * 8) {
+				std::cerr << "Burst length must be at most " << maxBurstLength << " bits"
+						  << (runExhaustive ? " with --exhaustive" : "") << " and the message size" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		if (errorModel == ErrorModel::Distinct) {
+			const uint32_t maxNrBitError = sweep.nrBitErrors.empty() ? nrBitError : sweep.nrBitErrors.back();
+			const uint32_t minMessageSize = sweep.messageSizes.empty()
+												? dataSize * sizeof(CRCInt)
+												: *std::min_element(sweep.messageSizes.begin(), sweep.messageSizes.end());
+			if (runImportance || maxNrBitError > minMessageSize * 8) {
+				std::cerr << "Distinct errors do not support the importance mode or more bit errors than message bits"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
 
 		/*	*/
 		const std::string &crcStr = result["crc"].as<std::string>();
-		auto foundItem = table.find(crcStr);
-		if (foundItem == table.end()) {
-			std::cerr << "Invalid CRC Options " << crcStr << std::endl;
+		std::vector<std::string> crcNames;
+		if (!parseCRCAlgorithmList(crcStr, crcNames)) {
 			return EXIT_FAILURE;
 		}
-		crcAlgorithm = (*foundItem).second;
 
-		/*	*/
-		const uint32_t numTasks = nrChunk; /// marl::Thread::numLogicalCPUs();
-		const uint64_t numLocalSamplesPTask = samples / numTasks;
-		assert(numLocalSamplesPTask > 0);
+		/*	A custom CRC is evaluated alone, unless algorithms to compare it with are listed.	*/
+		if (result.count("poly") > 0) {
+			if (result.count("width") == 0) {
+				std::cerr << "Custom CRC requires a width" << std::endl;
+				return EXIT_FAILURE;
+			}
+			const auto parseParameter = [](const std::string &text) {
+				size_t parsed;
+				const uint64_t value = std::stoull(text, &parsed, 0);
+				if (parsed != text.size()) {
+					throw std::invalid_argument("Invalid CRC parameter " + text);
+				}
+				return value;
+			};
+			const CRCParameters parameters = {
+				parseParameter(result["poly"].as<std::string>()), result["width"].as<uint32_t>(),
+				parseParameter(result["init"].as<std::string>()), parseParameter(result["xorout"].as<std::string>()),
+				result["refin"].as<bool>(),						  result["refout"].as<bool>()};
+			const uint64_t widthMask = parameters.width >= 64 ? ~static_cast<uint64_t>(0)
+															  : (static_cast<uint64_t>(1) << parameters.width) - 1;
+			if (parameters.width < 1 || parameters.width > 64 || (parameters.polynomial & ~widthMask) != 0 ||
+				(parameters.initialValue & ~widthMask) != 0 || (parameters.finalXOR & ~widthMask) != 0) {
+				std::cerr << "Custom CRC width must be within [1, 64] and its parameters within the width" << std::endl;
+				return EXIT_FAILURE;
+			}
+			CRCCustomKernel::setParameters(parameters);
+
+			if (result.count("crc") == 0) {
+				crcNames.clear();
+			}
+			if (std::find(crcNames.begin(), crcNames.end(), customCRCName) == crcNames.end()) {
+				crcNames.push_back(customCRCName);
+			}
+		} else if (std::find(crcNames.begin(), crcNames.end(), customCRCName) != crcNames.end()) {
+			std::cerr << "Custom CRC requires --poly and --width" << std::endl;
+			return EXIT_FAILURE;
+		}
+		crcAlgorithm = crcAlgorithmTable.at(crcNames.front());
+
+		/*	The phases are those of sampling one message at a time against a single algorithm.	*/
+		const uint32_t profileInterval = result["profile"].as<uint32_t>();
+		if (profileInterval > 0 &&
+			(!sweepStr.empty() || !searchStr.empty() || runExhaustive || runImportance || maxCorrectedBits > 0 ||
+			 batchLanes > 0 || crcNames.size() > 1)) {
+			std::cerr << "Profile requires a single algorithm and does not support the sweep, search, exhaustive, "
+						 "importance, error correction or batch mode"
+					  << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	A sampling run counts the collisions of every algorithm, times every cell and bit error count of a
+		 *	sweep. The search keeps its own checkpoints.	*/
+		size_t nrCheckpointCounters = crcNames.size();
+		if (!sweep.nrBitErrors.empty()) {
+			nrCheckpointCounters *= sweep.messageSizes.size() * sweep.probabilities.size() * sweep.nrBitErrors.size();
+		}
+		const std::string sampleSpec = formatSampleSpec(crcNames, sampleOptions, sweepStr, samples);
+		if (resumePath.empty() || isSearch) {
+			checkpointer.state.spec = sampleSpec;
+			checkpointer.state.seed = seed;
+			checkpointer.state.nrCollisions.assign(nrCheckpointCounters, 0);
+		} else if (checkpointer.state.spec != sampleSpec || checkpointer.state.seed != seed ||
+				   checkpointer.state.nrCollisions.size() != nrCheckpointCounters) {
+			std::cerr << "Checkpoint " << resumePath << " belongs to another run" << std::endl;
+			return EXIT_FAILURE;
+		} else if (checkpointer.state.nthRun > 0 && checkpointer.state.nextBlock == 0 && !runForever) {
+			std::cerr << "Checkpoint " << resumePath << " holds a completed run, continue it with --forever"
+					  << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (!checkpointer.path.empty()) {
+			if (!isSearch && (runImportance || maxCorrectedBits > 0 || runExhaustive)) {
+				std::cerr << "Checkpoints do not support the importance, error correction or exhaustive mode"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (isSearch && !resumePath.empty()) {
+				FILE *resumeFile = fopen(resumePath.c_str(), "r");
+				if (resumeFile == nullptr) {
+					std::cerr << "Failed to open the checkpoint " << resumePath << std::endl;
+					return EXIT_FAILURE;
+				}
+				fclose(resumeFile);
+			}
+			checkpointer.clock = CheckpointClock(true);
+			installTerminationHandler();
+		}
+
+		/*	Select the fastest kernel implementation supported by the CPU, unless forced.	*/
+		const std::string &kernelStr = result["kernel"].as<std::string>();
+		CRCImplementation forcedImplementation;
+		if (!kernelStr.empty() && !parseCRCImplementation(kernelStr, forcedImplementation)) {
+			std::cerr << "Invalid kernel " << kernelStr << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::vector<CRCImplementation> crcImplementations;
+		for (const std::string &crcName : crcNames) {
+			const CRCAlgorithm algorithm = crcAlgorithmTable.at(crcName);
+			if (!kernelStr.empty()) {
+				if (!dispatchCRCAlgorithm(algorithm, [&](auto kernel) {
+						return decltype(kernel)::isImplementationSupported(forcedImplementation);
+					})) {
+					std::cerr << "Kernel " << kernelStr << " is not supported for " << crcName << std::endl;
+					return EXIT_FAILURE;
+				}
+				dispatchCRCAlgorithm(algorithm,
+									 [&](auto kernel) { decltype(kernel)::setImplementation(forcedImplementation); });
+				crcImplementations.push_back(forcedImplementation);
+			} else {
+				crcImplementations.push_back(dispatchCRCAlgorithm(
+					algorithm, [](auto kernel) { return selectCRCImplementation<decltype(kernel)>(); }));
+			}
+		}
+
+		if (result.count("version") > 0) {
+			const CPUFeatures &cpuFeatures = getCPUFeatures();
+			std::cout << "Version: " << CRC_ANALYSIS_STR << " hash: " << CRC_ANALYSIS_GITCOMMIT_STR
+					  << " branch: " << CRC_ANALYSIS_GITBRANCH_TR << std::endl;
+			for (size_t i = 0; i < crcNames.size(); i++) {
+				std::cout << "Kernel: " << crcNames[i] << " " << getCRCImplementationName(crcImplementations[i])
+						  << " (sse4.2: " << cpuFeatures.sse42 << " pclmul: " << cpuFeatures.pclmul
+						  << " avx2: " << cpuFeatures.avx2 << ")" << std::endl;
+			}
+			return EXIT_SUCCESS;
+		}
+
+		/*	Validate the compile-time kernels against the CRCpp reference.	*/
+		assert(std::all_of(crcNames.begin(), crcNames.end(), [](const std::string &crcName) {
+			const CRCAlgorithm algorithm = crcAlgorithmTable.at(crcName);
+			return dispatchCRCAlgorithm(algorithm, [&](auto kernel) {
+				const std::vector<CRCInt> validationMsg = {0x12345678, 0x9ABCDEF0, 0x0F1E2D3C};
+				return computeCRC<decltype(kernel)>(validationMsg) == computeReferenceCRC(algorithm, validationMsg);
+			});
+		}));
+
+		/*	Exhaustive enumeration covers every weight unless a specific number of bit errors is requested.	*/
+		const unsigned int exhaustiveWeight =
+			result.count("nr-of-error-bits") > 0 ? nrBitError : exhaustiveMaxWeight;
+		if (runExhaustive && burstLength == 0) {
+			if (exhaustiveWeight < 1 || exhaustiveWeight > exhaustiveMaxWeight) {
+				std::cerr << "Exhaustive mode supports 1 to " << exhaustiveMaxWeight << " bit errors" << std::endl;
+				return EXIT_FAILURE;
+			}
+			if (dataSize * sizeof(CRCInt) * 8 > exhaustiveMaxMessageBits) {
+				std::cerr << "Exhaustive mode supports messages up to " << exhaustiveMaxMessageBits / 8 << " bytes"
+						  << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		/*	The analytic mode covers the bit error counts up to the requested one.	*/
+		const unsigned int analyticWeight =
+			result.count("nr-of-error-bits") > 0 ? nrBitError : analyticDefaultMaxWeight;
+		if (runAnalytic) {
+			for (const std::string &crcName : crcNames) {
+				const unsigned int width =
+					dispatchCRCAlgorithm(crcAlgorithmTable.at(crcName),
+										 [](auto kernel) { return decltype(kernel)::width; });
+				if (width > analyticMaxWidth) {
+					std::cerr << "Analytic mode supports CRCs up to " << analyticMaxWidth << " bits, " << crcName
+							  << " has " << width << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+
+		if (samples == 0) {
+			std::cerr << "Number of samples must be positive" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/*	Results are written by a single aggregator, opened before the scheduler so that it outlives the tasks.	*/
+		ResultFormat resultFormat;
+		const std::string &resultFormatStr = result["output-format"].as<std::string>();
+		if (!parseResultFormat(resultFormatStr, resultFormat)) {
+			std::cerr << "Invalid output format " << resultFormatStr << std::endl;
+			return EXIT_FAILURE;
+		}
+		const std::string &outputPath = result["output"].as<std::string>();
+		FILE *outputFile = stdout;
+		if (!outputPath.empty()) {
+			outputFile = fopen(outputPath.c_str(), "w");
+			if (outputFile == nullptr) {
+				std::cerr << "Failed to open " << outputPath << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		defer(if (outputFile != stdout) fclose(outputFile));
+		ResultsWriter writer(resultFormat, outputFile, z, shard.index, shard.count);
 
 		/*	*/
-		marl::Scheduler scheduler(marl::Scheduler::Config::allCores());
+		marl::Scheduler::Config schedulerConfig = marl::Scheduler::Config::allCores();
+		if (nrThreads > 0) {
+			schedulerConfig.setWorkerThreadCount(nrThreads);
+		}
+		marl::Scheduler scheduler(schedulerConfig);
 		scheduler.bind();
 		defer(scheduler.unbind()); // Automatically unbind before returning.
 
-		do {
+		/*	The tasks claim the samples dynamically, a task per worker thread is enough unless requested otherwise.	*/
+		const uint32_t numTasks =
+			nrChunk > 0 ? nrChunk : std::max(1, static_cast<int>(scheduler.config().workerThread.count));
 
-			// Create an event that is manually reset.
-			marl::Event sayHello(marl::Event::Mode::Manual);
-			// Create a WaitGroup with an initial count of numTasks.
-			marl::WaitGroup saidHello(numTasks);
+		/*	One counter shard per worker thread, plus the calling thread.	*/
+		ShardedCounters counters(scheduler.config().workerThread.count + 1);
 
-			for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
-				marl::schedule([&] { // All marl primitives are capture-by-value.
-					std::vector<CRCInt> originalMsg(dataSize);
-					std::vector<CRCInt> MsgWithError(dataSize);
-					PGSRandom randGen;
-					UniformRandom bitRandGen;
-
-					/*	*/
-					for (uint64_t i = 0; i < numLocalSamplesPTask; i++) {
-						generateRandomMessage(originalMsg, dataSize, randGen);
-						setFlippedBitErrors(originalMsg, MsgWithError, bitRandGen, nrBitError, probablity);
-
-						std::uint64_t originalMsgCRC, errorMsgCRC;
-
-						/*	*/
-						originalMsgCRC = computeCRC(crcAlgorithm, originalMsg);
-						errorMsgCRC = computeCRC(crcAlgorithm, MsgWithError);
-
-						/*	If message are not equal but the CRC are equal means that there was a incorrect CRC!	*/
-						if (!isArrayEqual(originalMsg, MsgWithError) && originalMsgCRC == errorMsgCRC) {
-							nrCollision++;
-						}
+		if (!search.messageSizes.empty()) {
+			runSearch(search, checkpointer.path, numTasks, writer, counters);
+			if (isTerminationRequested()) {
+				std::cerr << "Terminated, the progress is saved in " << checkpointer.path << std::endl;
+				return EXIT_FAILURE;
+			}
+			return EXIT_SUCCESS;
+		}
+
+		/*	Every burst up to the burst length, at every position.	*/
+		if (runExhaustive && burstLength > 0) {
+			for (const std::string &crcName : crcNames) {
+				dispatchCRCAlgorithm(crcAlgorithmTable.at(crcName), [&](auto kernel) {
+					using Kernel = decltype(kernel);
+
+					const auto start = std::chrono::steady_clock::now();
+					const std::vector<BurstLengthResult> lengths = computeBurstUndetected(
+						BurstSyndromes(createSyndromeTable<Kernel>(dataSize * sizeof(CRCInt))), burstLength);
+					const double wallTime =
+						std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+					for (const BurstLengthResult &length : lengths) {
+						ResultRecord burst = {"burst", crcName, dataSize * sizeof(CRCInt), 0, 1.0f, 0, 0, 0,
+											  length.nrBursts, length.nrUndetected, wallTime};
+						burst.burstLength = length.length;
+						writer.write(burst);
 					}
+				});
+			}
+			return EXIT_SUCCESS;
+		}
 
-					/*	*/
-					volatile const uint64_t _current_nr_samples = nrOfSamples.fetch_add(numLocalSamplesPTask);
-					volatile const uint32_t _current_number_completed_task = nrTaskCompleted.fetch_add(1);
-					volatile const uint64_t _current_nr_collision = nrCollision.load();
+		if (runExhaustive) {
+			for (const std::string &crcName : crcNames) {
+				dispatchCRCAlgorithm(crcAlgorithmTable.at(crcName), [&](auto kernel) {
+					using Kernel = decltype(kernel);
 
-					/*	*/
-					// assert(_current_nr_samples > 0);
-					const double _collisionPerc = (double)_current_nr_collision / (double)_current_nr_samples;
-					printf("\rCRC: %s, [%d/%d] NumberOfSamples %ld, collision - count: %ld perc: %lf - nr-error-bit %d",
-						   crcStr.c_str(), _current_number_completed_task, numTasks, _current_nr_samples,
-						   _current_nr_collision, _collisionPerc, nrBitError);
+					const auto start = std::chrono::steady_clock::now();
+					const std::vector<ExhaustiveWeightResult> weights = computeExhaustiveUndetected(
+						createSyndromeTable<Kernel>(dataSize * sizeof(CRCInt)), exhaustiveWeight);
+					const double wallTime =
+						std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+					for (const ExhaustiveWeightResult &weight : weights) {
+						writer.write({"exhaustive", crcName, dataSize * sizeof(CRCInt), weight.weight, 1.0f, 0, 0, 0,
+									  weight.nrPatterns, weight.nrUndetected, wallTime});
+					}
+				});
+			}
+			return EXIT_SUCCESS;
+		}
 
-					fflush(stdout);
+		if (runAnalytic) {
+			for (const std::string &crcName : crcNames) {
+				dispatchCRCAlgorithm(crcAlgorithmTable.at(crcName), [&](auto kernel) {
+					using Kernel = decltype(kernel);
+					const uint64_t messageSize = dataSize * sizeof(CRCInt);
 
-					/*	*/
-					defer(saidHello.done());
-					sayHello.wait();
+					const auto start = std::chrono::steady_clock::now();
+					const std::vector<uint64_t> dualWeights =
+						computeDualWeightDistribution(createSyndromeTable<Kernel>(messageSize), Kernel::width);
 
+					for (unsigned int weight = 1; weight <= analyticWeight; weight++) {
+						const double wallTime =
+							std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+						ResultRecord analytic = {"analytic", crcName, messageSize, weight, 1.0f, 0, 0, 0, 0, 0, wallTime};
+						analytic.estimate = computeUndetectedRandomFlips(dualWeights, Kernel::width, weight);
+						writer.write(analytic);
+
+						ResultRecord distribution = {"weight", crcName, messageSize, weight, 1.0f, 0, 0, 0, 0, 0, wallTime};
+						distribution.estimate = computeUndetectedWeightFraction(dualWeights, Kernel::width, weight);
+						writer.write(distribution);
+					}
+					if (bitErrorRate > 0) {
+						const double wallTime =
+							std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+						ResultRecord analytic = {"analytic", crcName, messageSize, 0, static_cast<float>(bitErrorRate),
+												 0, 0, 0, 0, 0, wallTime};
+						analytic.estimate = computeUndetectedBER(dualWeights, Kernel::width, bitErrorRate);
+						writer.write(analytic);
+					}
 				});
 			}
 
-			sayHello.signal(); // Unblock all the tasks.
+			/*	Sample as well when asked for, to put the Monte Carlo estimate next to the exact one.	*/
+			if (result.count("samples") == 0) {
+				return EXIT_SUCCESS;
+			}
+		}
+
+		/*	Records of the channel carry its bit error rate instead of a bit error count, as the analytic ones,
+		 *	records of bursts their burst length.	*/
+		if (errorModel == ErrorModel::Channel) {
+			nrBitError = 0;
+			probablity = static_cast<float>(bitErrorRate);
+		} else if (errorModel == ErrorModel::Burst) {
+			nrBitError = 0;
+		}
+
+		if (resultFormat == ResultFormat::Text) {
+			fprintf(outputFile, "Seed: %lu\n", (unsigned long)seed);
+			if (corpus) {
+				fprintf(outputFile, "Corpus: %s, %lu messages\n", corpusPath.c_str(),
+						(unsigned long)corpus->getNrMessages());
+			}
+		}
+		checkpointer.runStart = std::chrono::steady_clock::now();
+		const uint64_t shardSamples = SampleRangeScheduler::getShardSamples(sampleOptions.shard, samples);
+
+		if (!sweep.nrBitErrors.empty()) {
+			runSweep(sweep, crcNames, sampleOptions, samples, numTasks, runForever, writer, counters, checkpointer);
+		} else if (runImportance) {
+			runImportanceSampling(crcNames, sampleOptions, samples, numTasks, runForever, writer, counters);
+		} else if (maxCorrectedBits > 0) {
+			runErrorCorrection(crcNames, sampleOptions, maxCorrectedBits, samples, numTasks, runForever, writer,
+							   counters);
+		} else if (crcNames.size() == 1) {
+			SampleProfiler profiler(profileInterval, numTasks);
+
+			/*	Dispatch once, so that the sampling loop is specialized for the selected algorithm.	*/
+			dispatchCRCAlgorithm(crcAlgorithm, [&](auto kernel) {
+				using Kernel = decltype(kernel);
+
+				/*	Shared read-only syndromes for computing the error message CRC incrementally.	*/
+				const ErrorSyndromes syndromes = createSampleSyndromes<Kernel>(sampleOptions);
+
+				uint64_t nthRun = checkpointer.state.nthRun;
+				uint64_t firstBlock = checkpointer.state.nextBlock;
+				counters.restore(checkpointer.state.nrSamples, checkpointer.state.nrCollisions.front());
+				do {
+					/*	Every block of every run samples its own random streams.	*/
+					SampleRangeScheduler ranges(SampleRangeScheduler::getNrBlocks(samples), numTasks,
+												sampleOptions.shard, firstBlock);
+					const uint64_t streamBase = nthRun * ranges.getNrBlocks();
+					firstBlock = 0;
+
+					const std::vector<SampleTaskTotals> taskTotals = runSampleTasks(
+						ranges, numTasks, counters,
+						[&](uint32_t nthTask, uint64_t block) {
+							const uint64_t nrSamples = SampleRangeScheduler::getBlockSamples(block, samples);
+							uint64_t nrCollisions;
+							if (sampleOptions.batchLanes > 0) {
+								nrCollisions = sampleCollisionsBatched<Kernel>(sampleOptions, syndromes, nrSamples,
+																			   streamBase + block);
+							} else if (profileInterval > 0) {
+								nrCollisions = sampleCollisions<Kernel, true>(sampleOptions, syndromes, nrSamples,
+																			  streamBase + block,
+																			  profiler.getTaskProfile(nthTask));
+							} else {
+								nrCollisions =
+									sampleCollisions<Kernel>(sampleOptions, syndromes, nrSamples, streamBase + block);
+							}
+							return std::make_pair(nrSamples, nrCollisions);
+						},
+						[&] {
+							const double wallTime = checkpointer.getWallTime();
+							ResultRecord progress = {"progress", crcNames.front(), dataSize * sizeof(CRCInt),
+													 nrBitError, probablity, seed, 0, numTasks,
+													 counters.getTotalSamples(), counters.getTotalCollisions(),
+													 wallTime};
+							progress.targetSamples = (nthRun + 1) * shardSamples;
+							progress.burstLength = burstLength;
+							writer.write(progress);
+
+							/*	Stop early once the interval of the collision rate is tight enough.	*/
+							return targetRelativeError > 0 &&
+								   isIntervalConverged(progress.collisions, progress.samples, z, targetRelativeError);
+						},
+						checkpointer.clock,
+						[&](uint64_t nextBlock) {
+							checkpointer.save(nthRun, nextBlock, counters.getTotalSamples(),
+											  {counters.getTotalCollisions()});
+						});
+					if (isTerminationRequested()) {
+						break;
+					}
+					nthRun++;
+
+					for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+						const SampleTaskTotals &totals = taskTotals[nthTask];
+						ResultRecord task = {"task", crcNames.front(), dataSize * sizeof(CRCInt), nrBitError, probablity,
+											 seed, nthTask, numTasks, totals.nrSamples, totals.nrCollisions,
+											 totals.busySeconds};
+						task.burstLength = burstLength;
+						writer.write(task);
+					}
+
+					const double wallTime = checkpointer.getWallTime();
+					ResultRecord final = {"final", crcNames.front(), dataSize * sizeof(CRCInt), nrBitError, probablity,
+										  seed, 0, numTasks, counters.getTotalSamples(), counters.getTotalCollisions(),
+										  wallTime};
+					final.burstLength = burstLength;
+					writer.write(final);
+					writeWorkerRecords(writer, counters, seed);
+					checkpointer.save(nthRun, 0, counters.getTotalSamples(), {counters.getTotalCollisions()});
+				} while (runForever);
+
+				if (profileInterval > 0) {
+					writer.flush();
+					profiler.print(stderr, crcNames.front(), dataSize * sizeof(CRCInt), counters);
+				}
+			});
+		} else {
+			/*	Every sample is evaluated against all the algorithms, messages and errors are generated once.	*/
+			std::vector<SampleAlgorithm> algorithms;
+			for (const std::string &crcName : crcNames) {
+				const CRCAlgorithm algorithm = crcAlgorithmTable.at(crcName);
+				algorithms.push_back(dispatchCRCAlgorithm(algorithm, [&](auto kernel) {
+					return createSampleAlgorithm<decltype(kernel)>(crcName, algorithm, sampleOptions);
+				}));
+			}
+			const size_t nrAlgorithms = algorithms.size();
+			/*	The collisions of every algorithm are published to the reporter as the samples are, sharded per
+			 *	worker thread. Every task also counts those of the current run on its own.	*/
+			std::vector<ShardedCounters> algorithmCounters;
+			algorithmCounters.reserve(nrAlgorithms);
+			for (size_t a = 0; a < nrAlgorithms; a++) {
+				algorithmCounters.emplace_back(counters.getNrShards());
+				algorithmCounters[a].restore(0, checkpointer.state.nrCollisions[a]);
+			}
+			std::vector<std::vector<uint64_t>> taskCollisions(numTasks);
+
+			/*	Collisions of every algorithm including the tasks of the current run.	*/
+			const auto getAlgorithmCollisions = [&] {
+				std::vector<uint64_t> nrCollisions(nrAlgorithms);
+				for (size_t a = 0; a < nrAlgorithms; a++) {
+					nrCollisions[a] = algorithmCounters[a].getTotalCollisions();
+				}
+				return nrCollisions;
+			};
+
+			uint64_t nthRun = checkpointer.state.nthRun;
+			uint64_t firstBlock = checkpointer.state.nextBlock;
+			counters.restore(checkpointer.state.nrSamples, 0);
+			do {
+				for (std::vector<uint64_t> &collisions : taskCollisions) {
+					collisions.assign(nrAlgorithms, 0);
+				}
+
+				SampleRangeScheduler ranges(SampleRangeScheduler::getNrBlocks(samples), numTasks, sampleOptions.shard,
+											firstBlock);
+				const uint64_t streamBase = nthRun * ranges.getNrBlocks();
+				firstBlock = 0;
 
-			saidHello.wait(); // Wait for all tasks to complete.
-		} while (runForever);
+				const std::vector<SampleTaskTotals> taskTotals = runSampleTasks(
+					ranges, numTasks, counters,
+					[&](uint32_t nthTask, uint64_t block) {
+						const uint64_t nrSamples = SampleRangeScheduler::getBlockSamples(block, samples);
+						std::vector<uint64_t> blockCollisions(nrAlgorithms, 0);
+						if (sampleOptions.batchLanes > 0) {
+							sampleCollisionsMultiBatched(sampleOptions, algorithms, nrSamples, streamBase + block,
+														 blockCollisions.data());
+						} else {
+							sampleCollisionsMulti(sampleOptions, algorithms, nrSamples, streamBase + block,
+												  blockCollisions.data());
+						}
+						for (size_t a = 0; a < nrAlgorithms; a++) {
+							taskCollisions[nthTask][a] += blockCollisions[a];
+							algorithmCounters[a].add(0, blockCollisions[a], 0);
+						}
+						return std::make_pair(nrSamples, static_cast<uint64_t>(0));
+					},
+					[&] {
+						const double wallTime = checkpointer.getWallTime();
+						ResultRecord progress = {"progress", "", dataSize * sizeof(CRCInt), nrBitError, probablity,
+												 seed, 0, numTasks, counters.getTotalSamples(), 0, wallTime};
+						progress.targetSamples = (nthRun + 1) * shardSamples;
+						progress.burstLength = burstLength;
+						writer.write(progress);
 
-		std::cout << std::endl;
+						/*	Stop early once the intervals of every algorithm are tight enough.	*/
+						if (targetRelativeError <= 0) {
+							return false;
+						}
+						for (const uint64_t nrCollisions : getAlgorithmCollisions()) {
+							if (!isIntervalConverged(nrCollisions, progress.samples, z, targetRelativeError)) {
+								return false;
+							}
+						}
+						return true;
+					},
+					checkpointer.clock,
+					[&](uint64_t nextBlock) {
+						checkpointer.save(nthRun, nextBlock, counters.getTotalSamples(), getAlgorithmCollisions());
+					});
+				if (isTerminationRequested()) {
+					break;
+				}
+				nthRun++;
+
+				for (uint32_t nthTask = 0; nthTask < numTasks; nthTask++) {
+					for (size_t a = 0; a < nrAlgorithms; a++) {
+						ResultRecord task = {"task", algorithms[a].name, dataSize * sizeof(CRCInt), nrBitError,
+											 probablity, seed, nthTask, numTasks, taskTotals[nthTask].nrSamples,
+											 taskCollisions[nthTask][a], taskTotals[nthTask].busySeconds};
+						task.burstLength = burstLength;
+						writer.write(task);
+					}
+				}
+
+				const double wallTime = checkpointer.getWallTime();
+				const std::vector<uint64_t> nrAlgorithmCollisions = getAlgorithmCollisions();
+				for (size_t a = 0; a < nrAlgorithms; a++) {
+					ResultRecord final = {"final", algorithms[a].name, dataSize * sizeof(CRCInt), nrBitError,
+										  probablity, seed, 0, numTasks, counters.getTotalSamples(),
+										  nrAlgorithmCollisions[a], wallTime};
+					final.burstLength = burstLength;
+					writer.write(final);
+				}
+				writeWorkerRecords(writer, counters, seed);
+				checkpointer.save(nthRun, 0, counters.getTotalSamples(), nrAlgorithmCollisions);
+			} while (runForever);
+		}
+
+		if (isTerminationRequested()) {
+			std::cerr << "Terminated, the progress is saved in " << checkpointer.path << std::endl;
+			return EXIT_FAILURE;
+		}
 	} catch (const std::exception &ex) {
 		std::cerr << ex.what();
 		return EXIT_FAILURE;